@@ -113,7 +113,7 @@ def grabjsonfromfile(fname):
 parser = argparse.ArgumentParser(description="Minion Builder")
 parser.add_argument('--domains64', action='store_const', const=["-DDOMAINS64"],
                     help='Enable 64-bit domains')
-parser.add_argument('--wdeg', help='Enable wdeg heuristics (yes/no, default = yes)')
+parser.add_argument('--wdeg', help='Ignored, wdeg heuristics are always available (yes/no)')
 
 parser.add_argument('--quick', action='store_const', const=['-DQUICK_COMPILE'],
                     help='Quick build')
@@ -195,13 +195,8 @@ for c in ['domains64', 'quick', 'debug', 'assertions', 'print', 'info', 'profile
     if getattr(arg, c) != None:
         commandargs = commandargs + getattr(arg, c)
 
-if getattr(arg, 'wdeg'):
-    if arg.wdeg == 'yes':
-        commandargs = commandargs + ["-DWDEG"]
-    elif arg.wdeg != 'no':
-        fatal_error("Invalid argument for --wdeg:" + arg.wdeg)
-else:
-    commandargs = commandargs + ["-DWDEG"]
+if getattr(arg, 'wdeg') and arg.wdeg not in ['yes', 'no']:
+    fatal_error("Invalid argument for --wdeg:" + arg.wdeg)
 
 if arg.extraflags:
     commandargs = commandargs + arg.extraflags.split()
@@ -379,6 +374,7 @@ minionlibsrclist = ['minion/BuildVariables.cpp',
 'minion/system/sha1.cpp',
 'minion/help/help.cpp',
 'minion/inputfile_parse/inputfile_parse.cpp',
+'minion/inputfile_parse/binary_instance.cpp',
 'minion/dump_state.cpp',
 'minion/parallel.cpp',
 'minion/search_dump.cpp',
@@ -754,6 +754,17 @@ class teststr2plus:
         return runtestgeneral("str2plus", False, options, [4], ["smallnum"], self, not options['reify'])
 
 
+class testcompacttable:
+    def printtable(self, domains):
+        cross=[]
+        crossprod(domains, [], cross)
+        tups=makeRandomTuples(cross)
+        return (tups,tups)
+
+    def runtest(self, options=dict()):
+        options['tabletype'] = "longtable"
+        return runtestgeneral("compacttable", False, options, [4], ["smallnum"], self, not options['reify'])
+
 class testshortstr2:
     def printtable(self, domains):
         cross=[]
@@ -7,8 +7,11 @@
 #include "preprocess.h"
 #include "search/search_control.h"
 
+#include "search/LearningSearchManager.h"
 #include "search/restartNewSearchManager.h"
 
+#include <mutex>
+
 #include "dump_state.hpp"
 
 using namespace ProbSpec;
@@ -74,6 +77,17 @@ void BuildCSP(CSPInstance& instance) {
   if(getOptions().dumptreeobj) {
     getOptions().dumptreeobj->initialVariables(getVars().getAllVars());
   }
+
+  // Weights are kept from the start, so failures during preprocessing count.
+  // A portfolio search may use weighted orders in any thread.
+  bool weighted = getOptions().portfolio;
+  for(const SearchOrder& so : instance.searchOrder) {
+    if(so.order == ORDER_WDEG || so.order == ORDER_DOMOVERWDEG)
+      weighted = true;
+  }
+  if(weighted)
+    getQueue().startWeighting();
+
   // Impose Constraints
   for(list<ConstraintBlob>::iterator it = instance.constraints.begin();
       it != instance.constraints.end(); it++) {
@@ -82,6 +96,9 @@ void BuildCSP(CSPInstance& instance) {
         }
   }
 
+  if(getOptions().propProfile)
+    getQueue().startProfiling();
+
   // Solve!
   getState().getOldTimer().maybePrintTimestepStore(cout, "Setup Time: ", "SetupTime", getTableOut(),
                                                    !getOptions().silent);
@@ -105,6 +122,82 @@ bool PreprocessCSP(CSPInstance& instance, SearchMethod args) {
     }
     return true;
 }
+
+// The variable orderings used, in turn, by threads 1, 2, ... of a portfolio
+// search. Thread 0 always searches as given on the command line.
+static const VarOrderEnum portfolioOrders[] = {ORDER_DOMOVERWDEG, ORDER_WDEG, ORDER_CONFLICT,
+                                               ORDER_SDF, ORDER_SRF};
+
+static shared_ptr<Controller::SearchManager>
+makePortfolioSearch(CSPInstance& instance, SearchMethod args, int thread) {
+  vector<SearchOrder> order = instance.searchOrder;
+  if(thread == 0) {
+    return Controller::makeSearch_manager(args.propMethod, order);
+  }
+
+  const int orderCount = sizeof(portfolioOrders) / sizeof(portfolioOrders[0]);
+  const int strategy = thread - 1;
+  for(SearchOrder& so : order) {
+    if(so.findOneAssignment) {
+      continue;
+    }
+    so.order = portfolioOrders[strategy % orderCount];
+    // Once every ordering is in use, use them again with random value orders.
+    if(strategy >= orderCount) {
+      for(UnsignedSysInt j = 0; j < so.valOrder.size(); ++j) {
+        so.valOrder[j] = VALORDER_RANDOM;
+      }
+    }
+  }
+
+  // Restarts can only be used when looking for one solution.
+  if(getOptions().sollimit == 1 && thread % 2 == 0) {
+    return Controller::make_restart_new_search_manager(args.propMethod, order);
+  }
+  return Controller::makeSearch_manager(args.propMethod, order);
+}
+
+// The search performed by one thread of a threaded search. Thread 0 is the
+// main thread, which has already built the CSP.
+static void ThreadSearchCSP(CSPInstance& instance, SearchMethod args, int thread) {
+  if(thread != 0) {
+    // Building constraints can fill in caches stored in the instance (for
+    // example tries for table constraints), so only build one at a time.
+    static std::mutex buildLock;
+    std::lock_guard<std::mutex> l(buildLock);
+    BuildCSP(instance);
+    if(!PreprocessCSP(instance, args)) {
+      return;
+    }
+  }
+
+  if(getOptions().portfolio) {
+    // Every thread searches the whole problem, with its own strategy. The
+    // first to finish has found the answer, so stops all the others.
+    shared_ptr<Controller::SearchManager> sm = makePortfolioSearch(instance, args, thread);
+    Parallel::joinThreadedSearch(thread);
+    try {
+      sm->search();
+    } catch(EndOfSearch) {}
+    Parallel::stopThreadedSearch();
+    return;
+  }
+
+  shared_ptr<Controller::StandardSearchManager> sm =
+      std::static_pointer_cast<Controller::StandardSearchManager>(
+          Controller::makeSearch_manager(args.propMethod, instance.searchOrder));
+
+  Parallel::joinThreadedSearch(thread);
+  vector<Controller::triple> prefix;
+  try {
+    while(Parallel::getThreadWork(prefix)) {
+      sm->search_subtree(prefix);
+    }
+  } catch(EndOfSearch) {
+    Parallel::stopThreadedSearch();
+  }
+}
+
 void SolveCSP(CSPInstance& instance, SearchMethod args) {
   // Check that when searching PropagateSAC does actually do the SAC over all
   // vars in any
@@ -118,7 +211,34 @@ void SolveCSP(CSPInstance& instance, SearchMethod args) {
 
   shared_ptr<Controller::SearchManager> sm;
 
-  if(getOptions().restart.active) {
+  if(getOptions().threads > 0) {
+    if(getOptions().restart.active || getOptions().parallel || getOptions().split ||
+       getOptions().tabulationMode || getOptions().dumptree || getOptions().dumptreeobj ||
+       getOptions().printonlyoptimal || getOptions().learning) {
+      D_FATAL_ERROR("-threads is not compatible with -restarts, -parallel, -split, -dumptree, "
+                    "-dumptreejson, -printonlyoptimal or -learning");
+    }
+    if(getOptions().portfolio && getOptions().sollimit != 1 &&
+       !getState().isOptimisationProblem()) {
+      D_FATAL_ERROR("-portfolio can only find one solution, or optimise");
+    }
+    if(!getState().isFailed()) {
+      Parallel::runThreadedSearch(getOptions().threads, [&](int thread) {
+        ThreadSearchCSP(instance, args, thread);
+      });
+    }
+    return;
+  }
+
+  if(getOptions().learning) {
+    if(getOptions().restart.active || getOptions().parallel || getOptions().split ||
+       getOptions().tabulationMode || getState().isOptimisationProblem() ||
+       args.propMethod.type != PropLevel_GAC) {
+      D_FATAL_ERROR("-learning is not compatible with -restarts, -parallel, -split, "
+                    "optimisation problems, or -prop-node other than GAC");
+    }
+    sm = Controller::make_learning_search_manager(args.propMethod, instance.searchOrder);
+  } else if(getOptions().restart.active) {
     if(getOptions().sollimit != 1) {
       D_FATAL_ERROR("-restarts is not compatible with -sollimit, or optimisation problems");
     }
@@ -587,6 +587,7 @@ struct GraphBuilder {
     case CT_HAGGISGAC:
     case CT_HAGGISGAC_STABLE:
     case CT_LIGHTTABLE:
+    case CT_COMPACTTABLE:
     case CT_STR: return colour_no_symmetry(b, "TABLE");
 
     case CT_WATCHED_NEGATIVE_TABLE:
@@ -728,6 +729,7 @@ struct InstanceStats {
     case CT_SHORTSTR:
     case CT_STR:
     case CT_SHORTSTR_CTUPLE:
+    case CT_COMPACTTABLE:
     case CT_LIGHTTABLE: (*table)++; break;
     case CT_GACLEXLEQ:
     case CT_QUICK_LEXLEQ:
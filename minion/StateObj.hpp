@@ -9,77 +9,45 @@
 #include "globals.h"
 #include "parallel/parallel.h"
 
-VARDEF(Memory searchMem_m);
-VARDEF(SearchOptions options_m);
-VARDEF(SearchState state_m);
-VARDEF(Queues queues_m);
-VARDEF(VariableContainer varContainer_m);
-VARDEF(BoolContainer bools_m);
-
+// Each of these is created the first time it is used by the current Globals.
 inline BoolContainer& getBools() {
-#ifdef LIBMINION
   if(!globals->bools_m) {
     globals->bools_m = new BoolContainer;
   }
   return *globals->bools_m;
-#else
-  return bools_m;
-#endif
 }
 inline SearchOptions& getOptions() {
-#ifdef LIBMINION
   if(!globals->options_m) {
     globals->options_m = new SearchOptions;
   }
   return *globals->options_m;
-#else
-  return GET_GLOBAL(options_m);
-#endif
 }
 inline SearchState& getState() {
-#ifdef LIBMINION
   if(!globals->state_m) {
     globals->state_m = new SearchState;
   }
   return *globals->state_m;
-#else
-  return GET_GLOBAL(state_m);
-#endif
 }
 inline Queues& getQueue() {
-#ifdef LIBMINION
   if(!globals->queues_m) {
     globals->queues_m = new Queues;
   }
   return *globals->queues_m;
-#else
-  return GET_GLOBAL(queues_m);
-#endif
 }
 inline Memory& getMemory() {
-#ifdef LIBMINION
   if(!globals->searchMem_m) {
     globals->searchMem_m = new Memory;
   }
   return *globals->searchMem_m;
-#else
-  return GET_GLOBAL(searchMem_m);
-#endif
 }
 inline VariableContainer& getVars() {
-#ifdef LIBMINION
   if(!globals->varContainer_m) {
     globals->varContainer_m = new VariableContainer;
   }
   return *globals->varContainer_m;
-#else
-  return GET_GLOBAL(varContainer_m);
-#endif
 }
 
-VARDEF(Parallel::ParallelData* parData_m);
 inline Parallel::ParallelData& getParallelData() {
-
   if(!GET_GLOBAL(parData_m)) {
     GET_GLOBAL(parData_m) = Parallel::setupParallelData();
   }
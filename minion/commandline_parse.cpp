@@ -35,6 +35,11 @@ void parseCommandLine(SearchMethod& args, SysInt argc, char** argv) {
       getOptions().redump = true;
     }
 
+    else if(command == string("-binaryout")) {
+      INCREMENT_i(-binaryout);
+      getOptions().binaryOut = argv[i];
+    }
+
     else if(command == string("-outputCompressedDomains")) {
       getOptions().outputCompressedDomains = true;
     }
@@ -258,6 +263,8 @@ void parseCommandLine(SearchMethod& args, SysInt argc, char** argv) {
       getOptions().tableout = true;
       INCREMENT_i(-jsontableout);
       getTableOut().set_json_filename(argv[i]);
+    } else if(command == string("-prop-profile")) {
+      getOptions().propProfile = true;
     }
 
     else if(command == string("-solsout") || command == string("-solsout0")) {
@@ -266,8 +273,8 @@ void parseCommandLine(SearchMethod& args, SysInt argc, char** argv) {
       }
       getOptions().solsoutWrite = true;
       INCREMENT_i(-solsout);
-      GET_GLOBAL(solsoutfile).open(argv[i], ios::app);
-      if(!GET_GLOBAL(solsoutfile)) {
+      GET_GLOBAL(solsoutfile)->open(argv[i], ios::app);
+      if(!*GET_GLOBAL(solsoutfile)) {
         ostringstream oss;
         oss << "Cannot open '" << argv[i] << "' for writing.";
         outputFatalError(oss.str());
@@ -281,8 +288,8 @@ void parseCommandLine(SearchMethod& args, SysInt argc, char** argv) {
       getOptions().solsoutWrite = true;
       getOptions().solsoutJson = true;
       INCREMENT_i(-jsonsolsout);
-      GET_GLOBAL(solsoutfile).open(argv[i], ios::app);
-      if(!GET_GLOBAL(solsoutfile)) {
+      GET_GLOBAL(solsoutfile)->open(argv[i], ios::app);
+      if(!*GET_GLOBAL(solsoutfile)) {
         ostringstream oss;
         oss << "Cannot open '" << argv[i] << "' for writing.";
         outputFatalError(oss.str());
@@ -314,6 +321,19 @@ void parseCommandLine(SearchMethod& args, SysInt argc, char** argv) {
       INCREMENT_i(-cores);
       getOptions().parallelcores = atoi(argv[i]);
       Parallel::setNumberCores(getOptions().parallelcores);
+    } else if(command == string("-threads")) {
+      INCREMENT_i(-threads);
+      getOptions().threads = atoi(argv[i]);
+      if(getOptions().threads < 1) {
+        outputFatalError("-threads requires a positive number of threads");
+      }
+    } else if(command == string("-portfolio")) {
+      INCREMENT_i(-portfolio);
+      getOptions().threads = atoi(argv[i]);
+      getOptions().portfolio = true;
+      if(getOptions().threads < 1) {
+        outputFatalError("-portfolio requires a positive number of threads");
+      }
     } else if(command == string("-steallow")) {
       getOptions().parallelStealHigh = false;
     }
@@ -340,6 +360,41 @@ void parseCommandLine(SearchMethod& args, SysInt argc, char** argv) {
       getOptions().restart.multiplier = fromstring<double>(argv[i]);
     } else if(command == string("-no-restarts-bias")) {
       getOptions().restart.bias = false;
+    } else if(command == string("-restarts-schedule")) {
+      INCREMENT_i("restarts schedule");
+      string schedule(argv[i]);
+      if(schedule == "geometric")
+        getOptions().restart.schedule = RESTART_GEOMETRIC;
+      else if(schedule == "luby")
+        getOptions().restart.schedule = RESTART_LUBY;
+      else if(schedule == "innerouter")
+        getOptions().restart.schedule = RESTART_INNER_OUTER;
+      else {
+        outputFatalError(" -restarts-schedule <geometric|luby|innerouter>");
+      }
+    } else if(command == string("-restarts-scale")) {
+      INCREMENT_i("restarts scale");
+      getOptions().restart.scale = fromstring<unsigned long long>(argv[i]);
+    } else if(command == string("-no-restarts-nogoods")) {
+      getOptions().restart.nogoods = false;
+    } else if(command == string("-weighting")) {
+      INCREMENT_i("weighting");
+      string scheme(argv[i]);
+      if(scheme == "wdeg")
+        getOptions().weighting = WEIGHTING_WDEG;
+      else if(scheme == "chs")
+        getOptions().weighting = WEIGHTING_CHS;
+      else {
+        outputFatalError(" -weighting <wdeg|chs>");
+      }
+    } else if(command == string("-weight-decay")) {
+      INCREMENT_i("weight decay");
+      getOptions().weightDecay = fromstring<double>(argv[i]);
+      if(getOptions().weightDecay <= 0 || getOptions().weightDecay > 1) {
+        outputFatalError("-weight-decay must be more than 0, and at most 1");
+      }
+    } else if(command == string("-learning")) {
+      getOptions().learning = true;
     } else if(command[0] == '-' && command != string("--")) {
       cout << "I don't understand '" << command << "'. Sorry. " << endl;
       exit(1);
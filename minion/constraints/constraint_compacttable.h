@@ -0,0 +1,444 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+/** @help constraints;compacttable Description
+An extensional constraint that enforces GAC, using the Compact-Table
+algorithm (Demeulenaere et al., CP 2016). The set of tuples which are still
+valid is kept as a bitset, and each literal has a precomputed bitset of the
+tuples which support it, so updating the table and looking for supports is
+done 64 tuples at a time. This is usually the fastest table propagator in
+Minion for large tables.
+*/
+
+/** @help constraints;compacttable Example
+
+compacttable is invoked in the same way as table and str2plus.
+
+**TUPLELIST**
+mycon 3 3
+0 0 1
+0 1 0
+1 0 0
+
+**CONSTRAINTS**
+compacttable([x,y,z], mycon)
+*/
+
+/** @help constraints;compacttable References
+help input tuplelist
+help constraints table
+help constraints str2plus
+*/
+
+#ifndef CONSTRAINT_COMPACTTABLE_H
+#define CONSTRAINT_COMPACTTABLE_H
+
+#include "constraint_checkassign.h"
+#include <vector>
+
+#include "arrayset.h"
+
+template <typename VarArray>
+struct CompactTable : public AbstractConstraint, Backtrackable {
+  virtual string constraintName() {
+    return "compacttable";
+  }
+
+  CONSTRAINT_ARG_LIST2(vars, tupleList);
+
+  typedef uint64_t word_type;
+  static const SysInt word_bits = 64;
+
+  VarArray vars;
+
+  std::shared_ptr<TupleList> tupleList;
+
+  bool constraintLocked;
+
+  SysInt numWords;
+
+  // The tuples which are still valid, as a reversible sparse bitset.
+  // Only the words index[0..limit) can be non-zero. Words are trailed
+  // when they change, limit is backtracked by Minion.
+  vector<word_type> words;
+  vector<SysInt> index;
+  ReversibleInt limit;
+
+  // Used while updating words.
+  vector<word_type> mask;
+
+  // Trail of (word, previous contents), with one mark per search depth.
+  // A word is only trailed once per depth, which wordStamp records.
+  vector<pair<SysInt, word_type>> trail;
+  vector<SysInt> trailMarks;
+  vector<UnsignedSysInt> wordStamp;
+  UnsignedSysInt currentStamp;
+
+  // For each literal (numbered from firstLiteral of its variable), the
+  // tuples which support it (numWords words each), and the word a support
+  // was last found in.
+  vector<SysInt> firstLiteral;
+  vector<word_type> supports;
+  vector<SysInt> residues;
+
+  // For each variable, the values which were in the domain when the
+  // constraint last propagated, as a sparse set. Values are only ever
+  // removed by swapping them past the end, so backtracking just restores
+  // the size (which is stored in backtracked memory).
+  vector<vector<DomainInt>> seenVals;
+  vector<vector<SysInt>> seenPos;
+  SysInt* seenSize;
+
+  // The variables which have changed since the last propagation.
+  arrayset sval;
+
+  // Temporary list of values removed from one variable.
+  vector<DomainInt> removedVals;
+
+  CompactTable(const VarArray& _vars, std::shared_ptr<TupleList> _tuples)
+      : vars(_vars), tupleList(_tuples), constraintLocked(false), limit(), currentStamp(1) {
+    if(tupleList->size() > 0) {
+      CHECK(tupleList->tupleSize() == (SysInt)vars.size(),
+            "Cannot use same table for two constraints with different numbers "
+            "of variables!");
+    }
+    const SysInt numVars = vars.size();
+    const SysInt numTuples = checked_cast<SysInt>(tupleList->size());
+    numWords = (numTuples + word_bits - 1) / word_bits;
+
+    words.resize(numWords, 0);
+    mask.resize(numWords);
+    wordStamp.resize(numWords, 0);
+    index.resize(numWords);
+    for(SysInt i = 0; i < numWords; ++i)
+      index[i] = i;
+
+    firstLiteral.resize(numVars + 1);
+    firstLiteral[0] = 0;
+    for(SysInt i = 0; i < numVars; ++i)
+      firstLiteral[i + 1] = firstLiteral[i] + checked_cast<SysInt>(vars[i].initialMax() -
+                                                                   vars[i].initialMin() + 1);
+    const SysInt numLiterals = firstLiteral[numVars];
+    supports.resize((size_t)numLiterals * numWords, 0);
+    residues.resize(numLiterals, 0);
+
+    // Tuples using a value outside a variable's initial domain are never
+    // valid, so are left out of the table.
+    for(SysInt t = 0; t < numTuples; ++t) {
+      const DomainInt* tuple = tupleList->getTupleptr(t);
+      bool valid = true;
+      for(SysInt i = 0; i < numVars && valid; ++i)
+        valid = (tuple[i] >= vars[i].initialMin() && tuple[i] <= vars[i].initialMax());
+      if(!valid)
+        continue;
+      const word_type bit = (word_type)1 << (t % word_bits);
+      words[t / word_bits] |= bit;
+      for(SysInt i = 0; i < numVars; ++i)
+        supportWords(i, tuple[i])[t / word_bits] |= bit;
+    }
+
+    limit = numWords;
+    removeZeroWords();
+
+    sval.initialise(0, numVars - 1);
+    seenVals.resize(numVars);
+    seenPos.resize(numVars);
+    seenSize = getMemory().backTrack().template requestArray<SysInt>(numVars);
+    for(SysInt i = 0; i < numVars; ++i) {
+      for(DomainInt val = vars[i].initialMin(); val <= vars[i].initialMax(); ++val) {
+        seenPos[i].push_back(seenVals[i].size());
+        seenVals[i].push_back(val);
+      }
+      seenSize[i] = seenVals[i].size();
+    }
+
+    trailMarks.push_back(0);
+    getState().getGenericBacktracker().add(this);
+  }
+
+  SysInt literal(SysInt var, DomainInt val) const {
+    return firstLiteral[var] + checked_cast<SysInt>(val - vars[var].initialMin());
+  }
+
+  word_type* supportWords(SysInt var, DomainInt val) {
+    return &supports[(size_t)literal(var, val) * numWords];
+  }
+
+  virtual SysInt dynamicTriggerCount() {
+    return vars.size();
+  }
+
+  void setupTriggers() {
+    for(SysInt i = 0; i < vars.size(); ++i) {
+      moveTriggerInt(vars[i], i, DomainChanged);
+    }
+  }
+
+  virtual void fullPropagate() {
+    setupTriggers();
+    limit = numWords;
+    removeZeroWords();
+
+    // pretend all variables have changed.
+    for(SysInt i = 0; i < (SysInt)vars.size(); i++)
+      sval.insert(i);
+
+    do_prop(true);
+  }
+
+  virtual vector<AnyVarRef> getVars() {
+    vector<AnyVarRef> ret;
+    ret.reserve(vars.size());
+    for(unsigned i = 0; i < vars.size(); ++i)
+      ret.push_back(vars[i]);
+    return ret;
+  }
+
+  virtual bool checkAssignment(DomainInt* v, SysInt vSize) {
+    const SysInt numTuples = checked_cast<SysInt>(tupleList->size());
+    for(SysInt t = 0; t < numTuples; ++t) {
+      if(std::equal(v, v + vSize, tupleList->getTupleptr(t)))
+        return true;
+    }
+    return false;
+  }
+
+  virtual bool getSatisfyingAssignment(box<pair<SysInt, DomainInt>>& assignment) {
+    // Any tuple still valid in the current domains will do. The bitset may
+    // be out of date, but every valid tuple is still in it.
+    const SysInt numVars = vars.size();
+    for(SysInt i = 0; i < limit; ++i) {
+      const SysInt w = index[i];
+      for(SysInt bit = 0; bit < word_bits; ++bit) {
+        if(!(words[w] & ((word_type)1 << bit)))
+          continue;
+        const DomainInt* tuple = tupleList->getTupleptr(w * word_bits + bit);
+        bool valid = true;
+        for(SysInt j = 0; j < numVars && valid; ++j)
+          valid = vars[j].inDomain(tuple[j]);
+        if(valid) {
+          for(SysInt j = 0; j < numVars; ++j)
+            assignment.push_back(make_pair(j, tuple[j]));
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  virtual AbstractConstraint* reverseConstraint() {
+    return forwardCheckNegation(this);
+  }
+
+  virtual void propagateDynInt(SysInt prop_var, DomainDelta) {
+    sval.insert(prop_var);
+
+    if(!constraintLocked) {
+      constraintLocked = true;
+      getQueue().pushSpecialTrigger(this);
+    }
+  }
+
+  virtual void specialUnlock() {
+    constraintLocked = false;
+    sval.clear();
+  }
+
+  virtual void specialCheck() {
+    constraintLocked = false;
+    D_ASSERT(!getState().isFailed());
+    do_prop(false);
+  }
+
+  void mark() {
+    trailMarks.push_back(trail.size());
+    currentStamp++;
+  }
+
+  void pop() {
+    const SysInt mark = trailMarks.back();
+    trailMarks.pop_back();
+    for(SysInt i = (SysInt)trail.size() - 1; i >= mark; --i)
+      words[trail[i].first] = trail[i].second;
+    trail.resize(mark);
+    currentStamp++;
+  }
+
+  void setWord(SysInt w, word_type val) {
+    if(wordStamp[w] != currentStamp) {
+      wordStamp[w] = currentStamp;
+      trail.push_back(make_pair(w, words[w]));
+    }
+    words[w] = val;
+  }
+
+  // Removes words which have become zero from index[0..limit).
+  void removeZeroWords() {
+    SysInt lim = limit;
+    for(SysInt i = lim - 1; i >= 0; --i) {
+      if(words[index[i]] == 0) {
+        std::swap(index[i], index[lim - 1]);
+        lim--;
+      }
+    }
+    limit = lim;
+  }
+
+  void clearMask() {
+    for(SysInt i = 0; i < limit; ++i)
+      mask[index[i]] = 0;
+  }
+
+  void addToMask(SysInt var, DomainInt val) {
+    const word_type* sup = supportWords(var, val);
+    for(SysInt i = 0; i < limit; ++i) {
+      const SysInt w = index[i];
+      mask[w] |= sup[w];
+    }
+  }
+
+  // Removes all tuples not in mask (or, if inverted, all tuples in mask).
+  template <bool Inverted>
+  void intersectWithMask() {
+    SysInt lim = limit;
+    for(SysInt i = lim - 1; i >= 0; --i) {
+      const SysInt w = index[i];
+      const word_type m = Inverted ? ~mask[w] : mask[w];
+      const word_type newWord = words[w] & m;
+      if(newWord != words[w]) {
+        setWord(w, newWord);
+        if(newWord == 0) {
+          std::swap(index[i], index[lim - 1]);
+          lim--;
+        }
+      }
+    }
+    limit = lim;
+  }
+
+  // Returns the index of a word where the table and the supports of
+  // (var,val) intersect, or -1 if there is none.
+  SysInt intersectIndex(SysInt var, DomainInt val) {
+    const word_type* sup = supportWords(var, val);
+    for(SysInt i = 0; i < limit; ++i) {
+      const SysInt w = index[i];
+      if(words[w] & sup[w])
+        return w;
+    }
+    return -1;
+  }
+
+  void removeSeen(SysInt var, DomainInt val) {
+    const SysInt pos = seenPos[var][checked_cast<SysInt>(val - vars[var].initialMin())];
+    D_ASSERT(pos < seenSize[var]);
+    const SysInt last = seenSize[var] - 1;
+    const DomainInt lastVal = seenVals[var][last];
+    seenVals[var][pos] = lastVal;
+    seenPos[var][checked_cast<SysInt>(lastVal - vars[var].initialMin())] = pos;
+    seenVals[var][last] = val;
+    seenPos[var][checked_cast<SysInt>(val - vars[var].initialMin())] = last;
+    seenSize[var] = last;
+  }
+
+  // Removes the tuples which were invalidated by values removed from var
+  // since the last propagation. Returns true if any values were removed.
+  bool updateTable(SysInt var) {
+    removedVals.clear();
+    for(SysInt j = 0; j < seenSize[var]; ++j) {
+      if(!vars[var].inDomain(seenVals[var][j]))
+        removedVals.push_back(seenVals[var][j]);
+    }
+    if(removedVals.empty())
+      return false;
+
+    for(SysInt j = 0; j < (SysInt)removedVals.size(); ++j)
+      removeSeen(var, removedVals[j]);
+
+    clearMask();
+    if((SysInt)removedVals.size() < seenSize[var]) {
+      // Incremental update: remove the supports of the removed values.
+      for(SysInt j = 0; j < (SysInt)removedVals.size(); ++j)
+        addToMask(var, removedVals[j]);
+      intersectWithMask<true>();
+    } else {
+      // Reset update: keep only the supports of the remaining values.
+      for(SysInt j = 0; j < seenSize[var]; ++j)
+        addToMask(var, seenVals[var][j]);
+      intersectWithMask<false>();
+    }
+    return true;
+  }
+
+  bool isSupported(SysInt var, DomainInt val) {
+    const SysInt lit = literal(var, val);
+    const SysInt res = residues[lit];
+    if(words[res] & supports[(size_t)lit * numWords + res])
+      return true;
+    const SysInt w = intersectIndex(var, val);
+    if(w == -1)
+      return false;
+    residues[lit] = w;
+    return true;
+  }
+
+  void filterDomains() {
+    const SysInt numVars = vars.size();
+    for(SysInt var = 0; var < numVars; ++var) {
+      if(vars[var].isBound()) {
+        DomainInt newMin = vars[var].min();
+        while(newMin <= vars[var].max() && !isSupported(var, newMin))
+          newMin++;
+        DomainInt newMax = vars[var].max();
+        while(newMax > newMin && !isSupported(var, newMax))
+          newMax--;
+        vars[var].setMin(newMin);
+        vars[var].setMax(newMax);
+      } else {
+        for(SysInt j = 0; j < seenSize[var]; ++j) {
+          const DomainInt val = seenVals[var][j];
+          if(!isSupported(var, val)) {
+            vars[var].removeFromDomain(val);
+            // val is swapped with the last seen value, which must be
+            // checked next.
+            removeSeen(var, val);
+            j--;
+          }
+        }
+      }
+      if(getState().isFailed())
+        return;
+    }
+  }
+
+  void do_prop(bool filterAll) {
+    bool changed = filterAll;
+    for(SysInt j = 0; j < sval.size; ++j)
+      changed |= updateTable(sval.vals[j]);
+    sval.clear();
+
+    if(limit == 0) {
+      getState().setFailed();
+      return;
+    }
+
+    // The last propagation left every value supported, so unless the table
+    // has changed there is nothing to do.
+    if(changed)
+      filterDomains();
+  }
+};
+
+template <typename T>
+AbstractConstraint* BuildCT_COMPACTTABLE(const T& t1, ConstraintBlob& b) {
+  return new CompactTable<T>(t1, b.tuples);
+}
+
+/* JSON
+  { "type": "constraint",
+    "name": "compacttable",
+    "internal_name": "CT_COMPACTTABLE",
+    "args": [ "read_list", "read_tuples" ]
+  }
+  */
+
+#endif
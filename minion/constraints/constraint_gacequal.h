@@ -54,14 +54,24 @@ struct GACEqualConstraint : public AbstractConstraint {
     var1.setMin(minlim);
     var2.setMin(minlim);
 
-    for(DomainInt val = var1.min(); val <= var1.max(); val++) {
-      if(!var2.inDomain(val)) {
-        var1.removeFromDomain(val);
+    if(getState().isFailed())
+      return;
+
+    // Both variables now have the same bounds, so a variable without holes
+    // removes nothing from the other, and the value-by-value scan against it
+    // can be skipped (domSize is cheap for every variable type).
+    if(!hasNoHoles(var2)) {
+      for(DomainInt val = var1.min(); val <= var1.max(); val++) {
+        if(!var2.inDomain(val)) {
+          var1.removeFromDomain(val);
+        }
       }
     }
-    for(DomainInt val = var2.min(); val <= var2.max(); val++) {
-      if(!var1.inDomain(val)) {
-        var2.removeFromDomain(val);
+    if(!hasNoHoles(var1)) {
+      for(DomainInt val = var2.min(); val <= var2.max(); val++) {
+        if(!var1.inDomain(val)) {
+          var2.removeFromDomain(val);
+        }
       }
     }
 
@@ -78,6 +88,11 @@ struct GACEqualConstraint : public AbstractConstraint {
     }
   }
 
+  template <typename Var>
+  static bool hasNoHoles(const Var& var) {
+    return var.domSize() == var.max() - var.min() + 1;
+  }
+
   virtual void propagateDynInt(SysInt pos, DomainDelta) {
     if(pos < dvar2) {
       DomainInt val = pos + var1.initialMin();
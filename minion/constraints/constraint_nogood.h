@@ -0,0 +1,114 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+#ifndef CONSTRAINT_NOGOOD_H
+#define CONSTRAINT_NOGOOD_H
+
+// A nogood learnt during search: vars[i] = vals[i] can't hold for every i.
+// This is the clause 'some vars[i] != vals[i]', propagated by watching two
+// literals which are not yet false, as in SAT solvers. A literal is false
+// once its variable is assigned its value.
+struct NogoodConstraint : public AbstractConstraint {
+  virtual string constraintName() {
+    return "nogood";
+  }
+
+  vector<AnyVarRef> vars;
+  vector<DomainInt> vals;
+
+  NogoodConstraint(const vector<AnyVarRef>& _vars, const vector<DomainInt>& _vals)
+      : vars(_vars), vals(_vals) {
+    D_ASSERT(vars.size() == vals.size());
+  }
+
+  virtual SysInt dynamicTriggerCount() {
+    return 2;
+  }
+
+  bool isFalse(SysInt i) {
+    return vars[i].isAssigned() && vars[i].assignedValue() == vals[i];
+  }
+
+  void makeTrue(SysInt i) {
+    // Bound variables can only lose values from their bounds.
+    if(vars[i].min() == vals[i])
+      vars[i].setMin(vals[i] + 1);
+    else if(vars[i].max() == vals[i])
+      vars[i].setMax(vals[i] - 1);
+    else
+      vars[i].removeFromDomain(vals[i]);
+  }
+
+  // The first literal after 'start' (and not 'skip') which is not false, or
+  // -1 if there is none.
+  SysInt findWatch(SysInt start, SysInt skip) {
+    const SysInt size = vars.size();
+    for(SysInt j = 1; j <= size; ++j) {
+      SysInt i = (start + j) % size;
+      if(i != skip && !isFalse(i))
+        return i;
+    }
+    return -1;
+  }
+
+  virtual void fullPropagate() {
+    SysInt first = findWatch(-1, -1);
+    if(first == -1) {
+      getState().setFailed();
+      return;
+    }
+
+    SysInt second = findWatch(first, first);
+    if(second == -1) {
+      makeTrue(first);
+      if(vars.size() == 1)
+        return;
+      // The nogood may be added below the root, so it must still be watched
+      // after backtracking. Nogoods learnt from conflicts put the literal
+      // which became false last at position 1, so that is watched.
+      second = (first == 1) ? 0 : 1;
+    }
+
+    triggerInfo(0) = first;
+    moveTriggerInt(vars[first], 0, Assigned);
+    triggerInfo(1) = second;
+    moveTriggerInt(vars[second], 1, Assigned);
+  }
+
+  virtual void propagateDynInt(SysInt dt, DomainDelta) {
+    D_ASSERT(dt == 0 || dt == 1);
+    SysInt watch = checked_cast<SysInt>(triggerInfo(dt));
+    if(!isFalse(watch))
+      return;
+
+    SysInt other = checked_cast<SysInt>(triggerInfo(1 - dt));
+    SysInt next = findWatch(watch, other);
+    if(next == -1) {
+      makeTrue(other);
+      return;
+    }
+
+    triggerInfo(dt) = next;
+    moveTriggerInt(vars[next], dt, Assigned);
+  }
+
+  virtual BOOL checkAssignment(DomainInt* v, SysInt vSize) {
+    D_ASSERT(vSize == (SysInt)vals.size());
+    for(SysInt i = 0; i < vSize; ++i) {
+      if(v[i] != vals[i])
+        return true;
+    }
+    return false;
+  }
+
+  // Only the false literals matter.
+  virtual bool explainsWith(SysInt var, DomainInt val) {
+    return val == vals[var];
+  }
+
+  virtual vector<AnyVarRef> getVars() {
+    return vars;
+  }
+};
+
+#endif
@@ -224,6 +224,11 @@ struct BoolLessSumConstraintDynamic : public AbstractConstraint {
     return count >= varSum;
   }
 
+  // Only the variables counted towards the limit matter.
+  virtual bool explainsWith(SysInt var, DomainInt val) {
+    return val == VarToCount;
+  }
+
   virtual vector<AnyVarRef> getVars() {
     vector<AnyVarRef> vars;
     vars.reserve(varArray.size());
@@ -122,6 +122,11 @@ struct BoolSATConstraintDynamic : public AbstractConstraint {
     return count > 0;
   }
 
+  // Only the false literals matter.
+  virtual bool explainsWith(SysInt var, DomainInt val) {
+    return val == 0;
+  }
+
   virtual vector<AnyVarRef> getVars() {
     vector<AnyVarRef> vars;
     vars.reserve(varArray.size());
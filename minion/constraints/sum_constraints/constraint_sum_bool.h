@@ -164,6 +164,11 @@ struct BoolLessSumConstraint : public AbstractConstraint {
     return valCount >= sum_limit;
   }
 
+  // Only the variables counted towards the limit matter.
+  virtual bool explainsWith(SysInt var, DomainInt val) {
+    return val == VarToCount;
+  }
+
   virtual vector<AnyVarRef> getVars() {
     vector<AnyVarRef> vars;
     vars.reserve(varArray.size());
@@ -7,9 +7,7 @@
 #include <ostream>
 #include <string>
 
-#include "system/system.h"
-
-#include "constants.h"
+#include "minion.h"
 
 using namespace std;
 
@@ -152,3 +150,72 @@ void printSearchInfo() {
            << endl;
   }
 }
+
+static string profileSeconds(unsigned long long ticks, double ticksPerSecond) {
+  ostringstream s;
+  s << fixed << setprecision(4) << ticks / ticksPerSecond;
+  return s.str();
+}
+
+static void setProfileTableOut(string prefix, const PropProfileCounters& p, double ticksPerSecond) {
+  getTableOut().set(prefix + "_Calls", p.calls);
+  getTableOut().set(prefix + "_Seconds", profileSeconds(p.ticks, ticksPerSecond));
+  getTableOut().set(prefix + "_Removed", p.removed);
+}
+
+static void printProfileLine(string name, const PropProfileCounters& p, double ticksPerSecond) {
+  cout << pad(name, 40) << padStart(tostring(p.calls), 14)
+       << padStart(profileSeconds(p.ticks, ticksPerSecond), 12) << padStart(tostring(p.removed), 14)
+       << endl;
+}
+
+void printPropProfile() {
+  const SysInt slowestCount = 10;
+  const vector<AbstractConstraint*>& cons = getState().getConstraintList();
+  const double ticksPerSecond = getQueue().profileTicksPerSecond();
+
+  map<string, PropProfileCounters> byType;
+  for(SysInt i = 0; i < (SysInt)cons.size(); ++i)
+    byType[cons[i]->constraintName()].add(cons[i]->profile);
+
+  vector<pair<string, PropProfileCounters>> types(byType.begin(), byType.end());
+  std::stable_sort(types.begin(), types.end(),
+                   [](const pair<string, PropProfileCounters>& a,
+                      const pair<string, PropProfileCounters>& b) {
+                     return a.second.ticks > b.second.ticks;
+                   });
+
+  vector<SysInt> slowest(cons.size());
+  for(SysInt i = 0; i < (SysInt)cons.size(); ++i)
+    slowest[i] = i;
+  std::stable_sort(slowest.begin(), slowest.end(), [&](SysInt a, SysInt b) {
+    return cons[a]->profile.ticks > cons[b]->profile.ticks;
+  });
+  slowest.resize(std::min<SysInt>(slowest.size(), slowestCount));
+
+  for(SysInt i = 0; i < (SysInt)types.size(); ++i)
+    setProfileTableOut("PropProfile_" + types[i].first, types[i].second, ticksPerSecond);
+  for(SysInt i = 0; i < (SysInt)slowest.size(); ++i) {
+    string prefix = "PropProfileSlowest" + tostring(i + 1);
+    getTableOut().set(prefix + "_Constraint",
+                      tostring(slowest[i]) + ":" + cons[slowest[i]]->constraintName());
+    setProfileTableOut(prefix, cons[slowest[i]]->profile, ticksPerSecond);
+  }
+
+  if(getOptions().silent)
+    return;
+
+  cout << "Propagation profile, by constraint type" << endl;
+  cout << pad("Constraint", 40) << padStart("Calls", 14) << padStart("Seconds", 12)
+       << padStart("Removed", 14) << endl;
+  for(SysInt i = 0; i < (SysInt)types.size(); ++i)
+    printProfileLine(types[i].first, types[i].second, ticksPerSecond);
+
+  cout << "Slowest constraints (numbered in input order, from 0)" << endl;
+  for(SysInt i = 0; i < (SysInt)slowest.size(); ++i) {
+    string name = tostring(slowest[i]) + ": " + cons[slowest[i]]->fullOutputName();
+    if(name.size() > 40)
+      name = name.substr(0, 36) + "...";
+    printProfileLine(name, cons[slowest[i]]->profile, ticksPerSecond);
+  }
+}
@@ -165,17 +165,15 @@ struct InfoRefType {
     return data.getBaseVar();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     VAR_INFO_ADDONE(VAR_TYPE, getBaseWdeg);
     return data.getBaseWdeg();
   }
 
-  void incWdeg() {
+  void incWdeg(double amount) {
     VAR_INFO_ADDONE(VAR_TYPE, incWdeg);
-    data.incWdeg();
+    data.incWdeg(amount);
   }
-#endif
 
   friend std::ostream& operator<<(std::ostream& o, const InfoRefType& ir) {
     return o << "InfoRef " << ir.data;
@@ -0,0 +1,47 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+#ifndef PROP_PROFILE_H
+#define PROP_PROFILE_H
+
+#include <chrono>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Support for -prop-profile, which counts how often each constraint
+// propagates, how long it takes, and how many values it removes.
+
+/// A cheap, increasing tick count: the CPU timestamp counter where there is
+/// one, and a steady clock (in nanoseconds) elsewhere.
+inline unsigned long long readProfileTicks() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+struct PropProfileCounters {
+  unsigned long long calls = 0;
+  unsigned long long ticks = 0;
+  unsigned long long removed = 0;
+
+  void add(const PropProfileCounters& p) {
+    calls += p.calls;
+    ticks += p.ticks;
+    removed += p.removed;
+  }
+};
+
+/// Prints the profile gathered by -prop-profile, for each type of constraint
+/// and for the slowest constraints, and stores it in the TableOut. Defined in
+/// get_info.cpp.
+void printPropProfile();
+
+#endif
@@ -1,24 +1,18 @@
 // Minion https://github.com/minion/minion
 // SPDX-License-Identifier: MPL-2.0
 
-// This file just defines all global variables, using "IN_MAIN"
+// This file defines the per-thread global state.
 
 // These are just because VC++ sucks.
 #define _CRT_SECURE_NO_DEPRECATE 1
 #define _CRT_NONSTDC_NO_DEPRECATE 1
 
-#ifndef IN_MAIN
-#define IN_MAIN
-#endif
-
 #include "globals.h"
 #include "minion.h"
 
 #include "constraint_defs.h"
 
-#ifdef LIBMINION
-Globals* globals = new Globals();
-#endif
+thread_local Globals* globals = nullptr;
 
 SysInt numOfConstraints = sizeof(constraint_list) / sizeof(ConstraintDef);
 
@@ -30,6 +24,12 @@ Globals::Globals() {
     varContainer_m = NULL;
     bools_m = NULL;
     parData_m = NULL;
+    callback = NULL;
+    solsoutfile = std::make_shared<std::ofstream>();
+}
+
+TableOut& getTableOut() {
+  return globals->tableout_m;
 }
 
 Globals::~Globals() {
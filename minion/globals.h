@@ -4,6 +4,7 @@
 #include "StateObj_forward.h"
 #include "variables/AnyVarRef.h"
 #include <fstream>
+#include <memory>
 #include <random>
 
 struct Globals {
@@ -16,7 +17,9 @@ struct Globals {
   Parallel::ParallelData* parData_m;
   bool(*callback)(void);
   std::mt19937 global_random_gen;
-  std::ofstream solsoutfile;
+  // Shared by all threads of a threaded search.
+  std::shared_ptr<std::ofstream> solsoutfile;
+  TableOut tableout_m;
   /*
    * Pointer trickery as compiler doesnt like globals.x when there are still
    * incomplete types (such as SearchOptions, ...).
@@ -29,8 +32,4 @@ public:
   ~Globals();
 };
 
-#ifdef LIBMINION
-extern Globals* globals;
-#endif
-
 #endif
@@ -35,12 +35,36 @@ Control search
 
 Make Minion run in parallel. When using this option, you should use
 -solsout to put the solutions in a file, as solutions may get mixed up
-on the terminal.
+on the terminal. When optimising, each new best solution is shared, so
+all processes only look for better ones.
 
 -cores <N>
 
 Number of cores to use when running in parallel
 
+-threads <N>
+
+Search using N threads in a single process. Each thread builds its own
+copy of the problem, and idle threads take unexplored parts of the
+search tree from busy ones. Unlike -parallel, this also works on
+Windows. Solutions are not printed in a fixed order, and -nodelimit
+applies to each thread separately. When optimising, each new best
+solution is shared, so all threads only look for better ones. This
+cannot be used with -restarts, -parallel, -split, -dumptree or
+-printonlyoptimal.
+
+-portfolio <N>
+
+Like -threads, but instead of sharing one search, each of the N threads
+searches the whole problem with a different strategy. The first thread
+searches as given on the command line, while the others use dom/wdeg,
+wdeg, conflict, sdf and srf variable orderings in turn (then the same
+orderings again with random value ordering), and different random
+seeds. When looking for one solution, every other thread also uses
+restarts. The first thread to find a solution, or prove there is none
+(or prove a solution is optimal), stops all the others. This can only be
+used to find one solution, or to optimise.
+
 -steallow
 
 When doing parallel search, "steal low" in the tree (that is, start new
@@ -66,6 +90,55 @@ The available orders are:
 -   wdeg - Weighted degree
 -   domoverwdeg - Domain size over weighted degree
 
+-weighting <scheme>
+
+Choose how the constraint weights used by the wdeg and domoverwdeg
+orderings are updated when a constraint fails. wdeg (the default) adds
+one to the weight. chs (Conflict History Search) moves the weight
+towards a reward which is larger the more recently the constraint last
+failed, so constraints which have stopped failing become less important.
+Weights are only kept when a weighted ordering is used, so other
+searches are not slowed down.
+
+-weight-decay <factor>
+
+With -restarts, multiply every constraint weight by the given factor
+(between 0 and 1) at each restart, so recent failures count for more
+than old ones. The default is 1, which keeps weights unchanged. CHS
+weights are also decayed by how long ago each constraint last failed.
+
+-restarts
+
+Search for one solution with restarts. Each search gives up after a
+number of backtracks, and the next search uses a random value ordering
+and a larger limit. By default, nogoods are recorded from each abandoned
+search, so later searches do not explore the same failed subtrees again,
+and an unsatisfiable problem is eventually proved to have no solution.
+This can't be used to find more than one solution, or to optimise.
+
+-   -restarts-schedule <schedule> chooses how the backtrack limit
+    changes between restarts. geometric (the default) multiplies it by
+    the multiplier. luby uses the Luby sequence (1, 1, 2, 1, 1, 2, 4, 1,
+    ...) times the scale. innerouter grows an inner limit by the
+    multiplier until it passes an outer limit, which then grows by the
+    multiplier while the inner limit starts again.
+-   -restarts-scale <N> sets the backtrack limit the schedule starts
+    from (default 10 for geometric, 100 otherwise).
+-   -restarts-multiplier <x> sets the multiplier (default 1.5).
+-   -no-restarts-bias makes the random value ordering unbiased.
+-   -no-restarts-nogoods turns off recording nogoods.
+
+-learning
+
+Learn from every failure. The failure is explained by the assignments
+which caused it, and these are resolved into a nogood (a 1-UIP nogood,
+as in SAT solvers), which is added to the problem. Search then jumps
+back to the deepest decision where the nogood prunes, which may skip
+many decisions. Each solution found adds a nogood ruling it out, so
+finding very many solutions is slow. This can only be used when every
+variable is Boolean, and not to optimise, or with -restarts, -threads,
+-parallel, -split or -prop-node other than GAC.
+
 -valorder <order>
 
 Choose the value ordering (overruling any selection in the input file).
@@ -178,6 +251,15 @@ This data includes minion version information, arguments to the
 executable, build and solve time statistics, etc. See the file itself
 for a precise schema of the supplied information.
 
+-prop-profile
+
+At the end of search, print how many times each type of constraint
+propagated, the time this took, and how many domain values it removed,
+followed by the same information for the ten slowest individual
+constraints. This is also stored in the output of -tableout and
+-jsontableout. Timing every propagation slows search a little. In
+threaded search only the first thread is profiled.
+
 -solsout <filename>
 
 Append all solutionsto a named file. Each solution is placed on a line,
@@ -203,6 +285,15 @@ Print the minion input instance file to standard out. No search is
 carried out when this switch is used. This can be used to update files
 in old versions of the Minion file format.
 
+-binaryout <filename>
+
+Write the minion input instance to the named file, in a binary form which
+Minion can load much faster than the text format. Give the binary file to
+Minion in place of the original instance. No search is carried out when
+this switch is used. The binary file records the instance as it was
+parsed, so parsing options such as -map-long-short are applied when it is
+written, and it can only be read by a Minion built the same way.
+
 -instancestats
 
 Output various statistics about the minion file, which can be used for
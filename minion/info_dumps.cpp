@@ -3,6 +3,7 @@
 #include "BuildVariables.h"
 
 #include "commandline_parse.h"
+#include "inputfile_parse/binary_instance.h"
 #include "inputfile_parse/inputfile_parse.h"
 
 #include "MILtools/print_CSP.h"
@@ -45,4 +46,9 @@ void infoDumps(CSPInstance& instance) {
     cout << printer.getInstance();
     exit(0);
   }
+
+  if(getOptions().binaryOut != "") {
+    writeBinaryInstance(instance, getOptions().binaryOut);
+    exit(0);
+  }
 }
\ No newline at end of file
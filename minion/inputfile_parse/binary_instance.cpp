@@ -0,0 +1,580 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+#include "binary_instance.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+const char binaryMagic[] = "MINIONBINARY";
+const size_t binaryMagicLength = sizeof(binaryMagic) - 1;
+
+// Increase this whenever the layout below changes.
+const int64_t binaryFormatVersion = 1;
+
+// Written after the version. Reading it back with a different byte order
+// gives a different value.
+const int64_t byteOrderCheck = 0x0102030405060708LL;
+
+struct BinaryWriter {
+  std::string out;
+
+  map<std::shared_ptr<TupleList>, int64_t> tupleIndex;
+  map<std::shared_ptr<ShortTupleList>, int64_t> shortTupleIndex;
+  map<shared_ptr<CSPInstance>, string> gadgetNames;
+
+  void writeInt(int64_t i) {
+    out.append(reinterpret_cast<const char*>(&i), sizeof(i));
+  }
+
+  void write(DomainInt i) {
+    writeInt(checked_cast<SysInt>(i));
+  }
+
+  void write(bool b) {
+    writeInt(b ? 1 : 0);
+  }
+
+  void write(const string& s) {
+    writeInt(s.size());
+    out.append(s);
+  }
+
+  void write(const Var& v) {
+    if(!v.isValid()) {
+      writeInt(VAR_INVALID);
+      writeInt(-1);
+    } else {
+      writeInt(v.type());
+      writeInt(v.pos());
+    }
+  }
+
+  void write(const Bounds& b) {
+    write(b.lowerBound);
+    write(b.upperBound);
+  }
+
+  void write(const ValOrder& v) {
+    writeInt(v.type);
+    writeInt(v.bias);
+  }
+
+  template <typename T, typename U>
+  void write(const pair<T, U>& p) {
+    write(p.first);
+    write(p.second);
+  }
+
+  template <typename T>
+  void write(const vector<T>& v) {
+    writeInt(v.size());
+    for(const T& t : v) {
+      write(t);
+    }
+  }
+
+  template <typename T>
+  void write(const set<T>& s) {
+    writeInt(s.size());
+    for(const T& t : s) {
+      write(t);
+    }
+  }
+
+  template <typename K, typename V>
+  void write(const map<K, V>& m) {
+    writeInt(m.size());
+    for(const auto& p : m) {
+      write(p);
+    }
+  }
+
+  void write(const SearchOrder& so) {
+    write(so.varOrder);
+    write(so.valOrder);
+    writeInt(so.order);
+    write(so.findOneAssignment);
+  }
+
+  void write(const ConstraintBlob& blob) {
+    write(blob.constraint->name);
+    write(blob.vars);
+    writeTupleRef(blob.tuples);
+    writeShortTupleRef(blob.shortTuples);
+    writeTupleRef(blob.tuples2);
+    write(blob.negs);
+    write(blob.constants);
+    writeInt(blob.gadget_prop_type.type);
+    write(blob.gadget_prop_type.limit);
+    if(blob.gadget) {
+      if(gadgetNames.count(blob.gadget) == 0) {
+        throw parse_exception("Internal error: constraint uses an unnamed gadget");
+      }
+      write(gadgetNames[blob.gadget]);
+    } else {
+      write(string());
+    }
+    write(blob.internal_constraints);
+  }
+
+  void writeTupleRef(const std::shared_ptr<TupleList>& tuples) {
+    if(!tuples) {
+      writeInt(-1);
+    } else if(tupleIndex.count(tuples) == 0) {
+      throw parse_exception("Internal error: constraint uses an unknown tuple list");
+    } else {
+      writeInt(tupleIndex[tuples]);
+    }
+  }
+
+  void writeShortTupleRef(const std::shared_ptr<ShortTupleList>& tuples) {
+    if(!tuples) {
+      writeInt(-1);
+    } else if(shortTupleIndex.count(tuples) == 0) {
+      throw parse_exception("Internal error: constraint uses an unknown short tuple list");
+    } else {
+      writeInt(shortTupleIndex[tuples]);
+    }
+  }
+
+  void writeTupleLists(const CSPInstance& instance) {
+    TupleListContainer& tlc = *instance.tupleListContainer;
+    writeInt(tlc.size());
+    for(SysInt i = 0; i < tlc.size(); ++i) {
+      std::shared_ptr<TupleList> tuples = tlc.getTupleList(i);
+      tupleIndex[tuples] = i;
+      write(tuples->getName());
+      write(tuples->size());
+      write(tuples->tupleSize());
+      // Tuples are written as one block, so they can be copied straight back.
+      out.append(reinterpret_cast<const char*>(tuples->getPointer()),
+                 sizeof(DomainInt) * checked_cast<SysInt>(tuples->size() * tuples->tupleSize()));
+    }
+
+    ShortTupleListContainer& stlc = *instance.shortTupleListContainer;
+    writeInt(stlc.size());
+    for(SysInt i = 0; i < stlc.size(); ++i) {
+      std::shared_ptr<ShortTupleList> tuples = stlc.getShortTupleList(i);
+      shortTupleIndex[tuples] = i;
+      write(tuples->getName());
+      writeShortTuples(*tuples->tuplePtr());
+      write(tuples->initialDomains());
+    }
+
+    writeInt(instance.table_symboltable.size());
+    for(const auto& p : instance.table_symboltable) {
+      write(p.first);
+      writeTupleRef(p.second);
+    }
+
+    writeInt(instance.shorttable_symboltable.size());
+    for(const auto& p : instance.shorttable_symboltable) {
+      write(p.first);
+      writeShortTupleRef(p.second);
+    }
+  }
+
+  // The variable in a short tuple is a SysInt, which is written directly
+  // rather than converted to a DomainInt.
+  void writeShortTuples(const vector<vector<pair<SysInt, DomainInt>>>& shortTuples) {
+    writeInt(shortTuples.size());
+    for(const auto& tuple : shortTuples) {
+      writeInt(tuple.size());
+      for(const auto& literal : tuple) {
+        writeInt(literal.first);
+        write(literal.second);
+      }
+    }
+  }
+
+  void writeInstance(const CSPInstance& instance) {
+    writeInt(instance.gadgetMap.size());
+    for(const auto& p : instance.gadgetMap) {
+      write(p.first);
+      BinaryWriter gadgetWriter;
+      gadgetWriter.writeInstance(*p.second);
+      out.append(gadgetWriter.out);
+      gadgetNames[p.second] = p.first;
+    }
+
+    const VarContainer& vars = instance.vars;
+    writeInt(vars.BOOLs);
+    write(vars.symbol_table);
+    write(vars.name_table);
+    write(vars.bound);
+    write(vars.sparseBound);
+    write(vars.discrete);
+    write(vars.sparseDiscrete);
+    write(vars.matrix_table);
+    write(vars.allVars);
+
+    writeTupleLists(instance);
+
+    writeInt(instance.constraints.size());
+    for(const ConstraintBlob& blob : instance.constraints) {
+      write(blob);
+    }
+
+    write(instance.searchOrder);
+    write(instance.permutation);
+    write(instance.symOrder);
+    write(instance.preprocess_vars);
+    write(instance.constructionSite);
+    write(instance.mutexDetectList);
+    write(instance.mutexDetectList2);
+    write(instance.is_optimisation_problem);
+    write(instance.is_optimisation_problem && instance.optimiseMinimising);
+    write(instance.optimiseVariables);
+    write(instance.print_matrix);
+    write(instance.allVars_list);
+  }
+};
+
+struct BinaryReader {
+  const char* pos;
+  const char* end;
+
+  vector<std::shared_ptr<TupleList>> tupleLists;
+  vector<std::shared_ptr<ShortTupleList>> shortTupleLists;
+  map<string, shared_ptr<CSPInstance>> gadgets;
+
+  BinaryReader(const char* _pos, const char* _end) : pos(_pos), end(_end) {}
+
+  void need(int64_t bytes) {
+    if(bytes < 0 || bytes > end - pos) {
+      throw parse_exception("Binary instance is truncated or corrupt");
+    }
+  }
+
+  int64_t readInt() {
+    need(sizeof(int64_t));
+    int64_t i;
+    memcpy(&i, pos, sizeof(i));
+    pos += sizeof(i);
+    return i;
+  }
+
+  // Every element of a list takes at least one byte, so no valid length
+  // can be larger than what remains of the file.
+  SysInt readLength() {
+    int64_t len = readInt();
+    need(len);
+    return checked_cast<SysInt>(len);
+  }
+
+  void read(DomainInt& i) {
+    i = readInt();
+  }
+
+  void read(bool& b) {
+    b = (readInt() != 0);
+  }
+
+  void read(string& s) {
+    SysInt len = readLength();
+    s.assign(pos, len);
+    pos += len;
+  }
+
+  void read(Var& v) {
+    int64_t type = readInt();
+    int64_t varPos = readInt();
+    if(type < 0 || type > VAR_INVALID) {
+      throw parse_exception("Binary instance contains an invalid variable");
+    }
+    if(type == VAR_INVALID) {
+      v = Var();
+    } else {
+      v = Var(static_cast<VariableType>(type), varPos);
+    }
+  }
+
+  void read(Bounds& b) {
+    read(b.lowerBound);
+    read(b.upperBound);
+  }
+
+  void read(ValOrder& v) {
+    int64_t type = readInt();
+    if(type < VALORDER_NONE || type > VALORDER_RANDOM) {
+      throw parse_exception("Binary instance contains an invalid value ordering");
+    }
+    v.type = static_cast<ValOrderEnum>(type);
+    v.bias = checked_cast<int>(readInt());
+  }
+
+  template <typename T, typename U>
+  void read(pair<T, U>& p) {
+    read(p.first);
+    read(p.second);
+  }
+
+  // Vars, Bounds and ValOrders have no useful default, so vectors are built
+  // by copying from a placeholder.
+  template <typename T>
+  void read(vector<T>& v, const T& placeholder) {
+    SysInt len = readLength();
+    v.assign(len, placeholder);
+    for(SysInt i = 0; i < len; ++i) {
+      read(v[i]);
+    }
+  }
+
+  template <typename T>
+  void read(vector<T>& v) {
+    read(v, T());
+  }
+
+  void read(vector<Bounds>& v) {
+    read(v, Bounds(0, 0));
+  }
+
+  void read(vector<ValOrder>& v) {
+    read(v, ValOrder(VALORDER_ASCEND));
+  }
+
+  template <typename T>
+  void read(set<T>& s) {
+    SysInt len = readLength();
+    for(SysInt i = 0; i < len; ++i) {
+      T t;
+      read(t);
+      s.insert(t);
+    }
+  }
+
+  template <typename K, typename V>
+  void read(map<K, V>& m) {
+    SysInt len = readLength();
+    for(SysInt i = 0; i < len; ++i) {
+      pair<K, V> p;
+      read(p);
+      m.insert(p);
+    }
+  }
+
+  void read(SearchOrder& so) {
+    read(so.varOrder);
+    read(so.valOrder);
+    int64_t order = readInt();
+    if(order < ORDER_NONE || order > ORDER_CONFLICT) {
+      throw parse_exception("Binary instance contains an invalid variable ordering");
+    }
+    so.order = static_cast<VarOrderEnum>(order);
+    read(so.findOneAssignment);
+  }
+
+  ConstraintDef* readConstraintDef() {
+    string name;
+    read(name);
+    for(SysInt i = 0; i < numOfConstraints; ++i) {
+      if(constraint_list[i].name == name) {
+        return constraint_list + i;
+      }
+    }
+    throw parse_exception("Binary instance contains unknown constraint '" + name + "'");
+  }
+
+  ConstraintBlob readConstraint() {
+    ConstraintBlob blob(readConstraintDef());
+    read(blob.vars);
+    blob.tuples = readTupleRef();
+    blob.shortTuples = readShortTupleRef();
+    blob.tuples2 = readTupleRef();
+    read(blob.negs);
+    read(blob.constants);
+    int64_t propType = readInt();
+    if(propType < PropLevel_None || propType > PropLevel_SSAC) {
+      throw parse_exception("Binary instance contains an invalid propagation level");
+    }
+    blob.gadget_prop_type.type = static_cast<PropagationType>(propType);
+    read(blob.gadget_prop_type.limit);
+    string gadgetName;
+    read(gadgetName);
+    if(!gadgetName.empty()) {
+      if(gadgets.count(gadgetName) == 0) {
+        throw parse_exception("Binary instance uses unknown gadget '" + gadgetName + "'");
+      }
+      blob.gadget = gadgets[gadgetName];
+    }
+    SysInt internalCount = readLength();
+    for(SysInt i = 0; i < internalCount; ++i) {
+      blob.internal_constraints.push_back(readConstraint());
+    }
+    return blob;
+  }
+
+  std::shared_ptr<TupleList> readTupleRef() {
+    int64_t i = readInt();
+    if(i == -1) {
+      return std::shared_ptr<TupleList>();
+    }
+    if(i < 0 || i >= (int64_t)tupleLists.size()) {
+      throw parse_exception("Binary instance refers to a missing tuple list");
+    }
+    return tupleLists[i];
+  }
+
+  std::shared_ptr<ShortTupleList> readShortTupleRef() {
+    int64_t i = readInt();
+    if(i == -1) {
+      return std::shared_ptr<ShortTupleList>();
+    }
+    if(i < 0 || i >= (int64_t)shortTupleLists.size()) {
+      throw parse_exception("Binary instance refers to a missing short tuple list");
+    }
+    return shortTupleLists[i];
+  }
+
+  void readTupleLists(CSPInstance& instance) {
+    SysInt tupleListCount = readLength();
+    for(SysInt i = 0; i < tupleListCount; ++i) {
+      string name;
+      read(name);
+      int64_t numTuples = readInt();
+      int64_t tupleLength = readInt();
+      if(numTuples < 0 || tupleLength < 0 ||
+         (tupleLength > 0 && numTuples > (end - pos) / tupleLength)) {
+        throw parse_exception("Binary instance is truncated or corrupt");
+      }
+      int64_t bytes = sizeof(DomainInt) * numTuples * tupleLength;
+      need(bytes);
+      std::shared_ptr<TupleList> tuples =
+          instance.tupleListContainer->getNewTupleList(numTuples, tupleLength);
+      memcpy(tuples->getPointer(), pos, bytes);
+      pos += bytes;
+      tuples->setName(name);
+      tuples->finalise_tuples();
+      tupleLists.push_back(tuples);
+    }
+
+    SysInt shortTupleListCount = readLength();
+    for(SysInt i = 0; i < shortTupleListCount; ++i) {
+      string name;
+      vector<vector<pair<SysInt, DomainInt>>> shortTuples;
+      vector<set<DomainInt>> initialDomains;
+      read(name);
+      readShortTuples(shortTuples);
+      read(initialDomains);
+      std::shared_ptr<ShortTupleList> tuples =
+          instance.shortTupleListContainer->getNewShortTupleList(shortTuples, initialDomains);
+      tuples->setName(name);
+      shortTupleLists.push_back(tuples);
+    }
+
+    SysInt tableNames = readLength();
+    for(SysInt i = 0; i < tableNames; ++i) {
+      string name;
+      read(name);
+      std::shared_ptr<TupleList> tuples = readTupleRef();
+      instance.table_symboltable[name] = tuples;
+      instance.table_nametable[tuples] = name;
+    }
+
+    SysInt shortTableNames = readLength();
+    for(SysInt i = 0; i < shortTableNames; ++i) {
+      string name;
+      read(name);
+      std::shared_ptr<ShortTupleList> tuples = readShortTupleRef();
+      instance.shorttable_symboltable[name] = tuples;
+      instance.shorttable_nametable[tuples] = name;
+    }
+  }
+
+  void readShortTuples(vector<vector<pair<SysInt, DomainInt>>>& shortTuples) {
+    shortTuples.resize(readLength());
+    for(auto& tuple : shortTuples) {
+      tuple.resize(readLength());
+      for(auto& literal : tuple) {
+        literal.first = checked_cast<SysInt>(readInt());
+        read(literal.second);
+      }
+    }
+  }
+
+  void readInstance(CSPInstance& instance) {
+    SysInt gadgetCount = readLength();
+    for(SysInt i = 0; i < gadgetCount; ++i) {
+      string name;
+      read(name);
+      shared_ptr<CSPInstance> gadget(new CSPInstance);
+      BinaryReader gadgetReader(pos, end);
+      gadgetReader.readInstance(*gadget);
+      pos = gadgetReader.pos;
+      instance.addGadgetSymbol(name, gadget);
+      gadgets[name] = gadget;
+    }
+
+    VarContainer& vars = instance.vars;
+    vars.BOOLs = checked_cast<SysInt>(readInt());
+    read(vars.symbol_table);
+    read(vars.name_table);
+    read(vars.bound);
+    read(vars.sparseBound);
+    read(vars.discrete);
+    read(vars.sparseDiscrete);
+    read(vars.matrix_table);
+    read(vars.allVars);
+
+    readTupleLists(instance);
+
+    SysInt constraintCount = readLength();
+    for(SysInt i = 0; i < constraintCount; ++i) {
+      instance.constraints.push_back(readConstraint());
+    }
+
+    read(instance.searchOrder);
+    read(instance.permutation);
+    read(instance.symOrder);
+    read(instance.preprocess_vars);
+    read(instance.constructionSite);
+    read(instance.mutexDetectList);
+    read(instance.mutexDetectList2);
+    read(instance.is_optimisation_problem);
+    read(instance.optimiseMinimising);
+    read(instance.optimiseVariables);
+    read(instance.print_matrix);
+    read(instance.allVars_list);
+  }
+};
+
+} // namespace
+
+bool isBinaryInstance(const char* data, size_t length) {
+  return length >= binaryMagicLength && memcmp(data, binaryMagic, binaryMagicLength) == 0;
+}
+
+void writeBinaryInstance(const CSPInstance& instance, const string& filename) {
+  BinaryWriter writer;
+  writer.out.append(binaryMagic, binaryMagicLength);
+  writer.writeInt(binaryFormatVersion);
+  writer.writeInt(byteOrderCheck);
+  writer.writeInt(sizeof(DomainInt));
+  writer.writeInstance(instance);
+
+  std::ofstream file(filename.c_str(), ios_base::out | ios_base::binary);
+  file.write(writer.out.data(), writer.out.size());
+  file.close();
+  if(!file) {
+    outputFatalError("Unable to write binary instance to '" + filename + "'");
+  }
+}
+
+void readBinaryInstance(CSPInstance& instance, const char* data, size_t length) {
+  D_ASSERT(isBinaryInstance(data, length));
+  BinaryReader reader(data + binaryMagicLength, data + length);
+  if(reader.readInt() != binaryFormatVersion) {
+    throw parse_exception("This binary instance was written by a different version of Minion");
+  }
+  if(reader.readInt() != byteOrderCheck || reader.readInt() != (int64_t)sizeof(DomainInt)) {
+    throw parse_exception("This binary instance was written on a different kind of machine, "
+                          "or by a differently built Minion");
+  }
+  reader.readInstance(instance);
+  if(reader.pos != reader.end) {
+    throw parse_exception("Binary instance has unexpected data at its end");
+  }
+}
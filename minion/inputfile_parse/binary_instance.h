@@ -0,0 +1,30 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+#ifndef BINARY_INSTANCE_H
+#define BINARY_INSTANCE_H
+
+#include "CSPSpec.h"
+
+// A binary form of a fully parsed CSPInstance, which loads much faster than
+// the text format. It is written by -binaryout, and read by passing the file
+// to Minion in place of a normal instance.
+//
+// The file starts with a magic string and a format version, followed by the
+// size and byte order of the integers it contains. Files written by a
+// different version of the format, or a Minion built with different integer
+// sizes, are rejected rather than misread.
+
+/// Returns true if the 'length' bytes at 'data' are the start of a binary
+/// instance.
+bool isBinaryInstance(const char* data, size_t length);
+
+/// Writes 'instance' to the file 'filename'.
+void writeBinaryInstance(const CSPInstance& instance, const string& filename);
+
+/// Fills in 'instance', which must be empty, from the binary instance in the
+/// 'length' bytes at 'data'. Throws a parse_exception if the data is not
+/// a valid binary instance.
+void readBinaryInstance(CSPInstance& instance, const char* data, size_t length);
+
+#endif
@@ -5,10 +5,18 @@
 #define CHEAPSTREAM_H
 
 #include <algorithm>
+#include <fstream>
 #include <istream>
 #include <sstream>
 #include <string>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef P
 #undef P
 #endif
@@ -16,6 +24,14 @@
 #define P(x)
 //#define P(x) cout << x << endl
 
+// Reads through a whole file held in memory. Regular files are mapped into
+// memory and parsed in place, while anything else (such as standard input or
+// a pipe) is first copied into a string.
+//
+// The parser peeks one character past the end of the input, and expects a
+// '\0' there. std::string provides this, and so does mmap, which zero-fills
+// the end of the last page of a file. Files whose size is an exact number of
+// pages have no such padding, so are copied instead.
 class CheapStream {
   const char* streamStart;
   const char* streamEnd;
@@ -23,6 +39,57 @@ class CheapStream {
 
   std::string s;
 
+  void* mappedData;
+  size_t mappedLength;
+
+  void useString() {
+    if(!s.empty()) {
+      streamStart = &*s.begin();
+      streamEnd = &*s.begin() + s.length();
+      streamPos = streamStart;
+    } else {
+      streamStart = streamEnd = streamPos = NULL;
+    }
+  }
+
+  void readStream(std::istream& i) {
+    std::streambuf* buf = i.rdbuf();
+    char chunk[1 << 16];
+    std::streamsize n;
+    while((n = buf->sgetn(chunk, sizeof(chunk))) > 0) {
+      s.append(chunk, n);
+    }
+    useString();
+  }
+
+  bool mapFile(const char* filename) {
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) {
+      return false;
+    }
+    bool mapped = false;
+    struct stat st;
+    if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 &&
+       st.st_size % sysconf(_SC_PAGESIZE) != 0) {
+      void* data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(data != MAP_FAILED) {
+        madvise(data, st.st_size, MADV_SEQUENTIAL);
+        mappedData = data;
+        mappedLength = st.st_size;
+        streamStart = static_cast<const char*>(data);
+        streamEnd = streamStart + mappedLength;
+        streamPos = streamStart;
+        mapped = true;
+      }
+    }
+    close(fd);
+    return mapped;
+#else
+    return false;
+#endif
+  }
+
 public:
   bool failFlag;
 
@@ -30,6 +97,15 @@ public:
     return streamPos - streamStart;
   }
 
+  /// The whole of the input, as one block of memory.
+  const char* getRawStart() const {
+    return streamStart;
+  }
+
+  size_t getRawLength() const {
+    return streamEnd - streamStart;
+  }
+
   void resetStream() {
     streamPos = streamStart;
     failFlag = false;
@@ -39,20 +115,55 @@ public:
       : streamStart(_streamStart),
         streamEnd(_streamEnd),
         streamPos(_streamStart),
+        mappedData(NULL),
+        mappedLength(0),
         failFlag(false) {}
 
   template <typename IStream>
-  CheapStream(IStream& i, const char* filename = "") : failFlag(false) {
-    std::ostringstream iss;
-    iss << i.rdbuf();
-    s = iss.str();
-    if(!s.empty()) {
-      streamStart = &*s.begin();
-      streamEnd = &*s.begin() + s.length();
-      streamPos = streamStart;
+  CheapStream(IStream& i, const char* filename = "")
+      : mappedData(NULL), mappedLength(0), failFlag(false) {
+    readStream(i);
+  }
+
+  /// Reads the file called 'filename'. Sets the fail flag if the file
+  /// can't be opened.
+  explicit CheapStream(const char* filename)
+      : streamStart(NULL),
+        streamEnd(NULL),
+        streamPos(NULL),
+        mappedData(NULL),
+        mappedLength(0),
+        failFlag(false) {
+    if(mapFile(filename)) {
+      return;
+    }
+    std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+    if(!file) {
+      failFlag = true;
+      return;
+    }
+    // Avoid growing the string repeatedly, when we can tell how big it will be.
+    file.seekg(0, std::ios_base::end);
+    std::streamoff length = file.tellg();
+    file.seekg(0, std::ios_base::beg);
+    if(length > 0) {
+      s.reserve(length);
     } else {
-      streamStart = streamEnd = streamPos = NULL;
+      file.clear();
     }
+    readStream(file);
+  }
+
+  // The stream points into its own storage, so must not be copied.
+  CheapStream(const CheapStream&) = delete;
+  CheapStream& operator=(const CheapStream&) = delete;
+
+  ~CheapStream() {
+#ifndef _WIN32
+    if(mappedData) {
+      munmap(mappedData, mappedLength);
+    }
+#endif
   }
 
   bool fail() {
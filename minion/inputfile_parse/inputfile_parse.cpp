@@ -4,8 +4,10 @@
 #include "inputfile_parse.h"
 
 #include "MinionThreeInputReader.hpp"
+#include "binary_instance.h"
 #include <fstream>
 #include <iostream>
+#include <memory>
 
 template <typename Reader, typename Stream>
 void ReadCSP(Reader& reader, ConcreteFileReader<Stream>* infile) {
@@ -25,26 +27,19 @@ void readInputFromFiles(ProbSpec::CSPInstance& instance, vector<string> fnames,
     if(fname->find_last_of(".") < fname->size())
       extension = fname->substr(fname->find_last_of("."), fname->size());
 
-    // We need to use a pointer here, as we want to declare the object inside a
-    // for loop,
-    // and we need it to live until after we've finished parsing.
-    // We use an auto_ptr because it will auto-delete on exit.
-    istream* file;
-
+    // Files given by name are read in place where possible. The stream is
+    // created once and owns its input, which must live until we've finished
+    // parsing.
+    std::unique_ptr<CheapStream> csPtr;
     if(*fname != "--") {
-      file = new ifstream(filename, ios_base::in | ios_base::binary);
-      if(!(*file)) {
+      csPtr.reset(new CheapStream(filename));
+      if(csPtr->fail()) {
         INPUT_ERROR("Can't open given input file '" + *fname + "'.");
       }
-    } else
-      file = &cin;
-
-    CheapStream cs(*file);
-
-    // After the CheapStream is created, the file is already fully read.
-    if(file != &cin) {
-      delete file;
+    } else {
+      csPtr.reset(new CheapStream(cin));
     }
+    CheapStream& cs = *csPtr;
 
     ConcreteFileReader<CheapStream> infile(cs, filename);
 
@@ -52,6 +47,20 @@ void readInputFromFiles(ProbSpec::CSPInstance& instance, vector<string> fnames,
       INPUT_ERROR("Can't open given input file '" + *fname + "'.");
     }
 
+    // A binary instance is already fully parsed, so needs no finalising.
+    if(isBinaryInstance(cs.getRawStart(), cs.getRawLength())) {
+      if(fnames.size() != 1) {
+        INPUT_ERROR("A binary instance can't be combined with other input files");
+      }
+      try {
+        readBinaryInstance(instance, cs.getRawStart(), cs.getRawLength());
+      } catch(const parse_exception& s) {
+        INPUT_ERROR(s.what());
+      }
+      getTableOut().set(string("Filename"), *fname);
+      continue;
+    }
+
     try {
       {
         string testName = infile.getString();
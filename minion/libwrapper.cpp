@@ -14,8 +14,12 @@
 #include "solver.h"
 #include "system/minlib/exceptions.hpp"
 #include "tuple_container.h"
+#include <chrono>
+#include <condition_variable>
 #include <iomanip>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #ifdef LIBMINION
 
@@ -23,113 +27,623 @@
 void doStandardSearch(CSPInstance& instance, SearchMethod args);
 void finaliseModel(CSPInstance& instance);
 
-extern Globals* globals;
-
 void resetMinion()
 {
   delete globals;
   globals = new Globals();
 }
 
-std::mutex global_minion_lock;
-ReturnCodes runMinion(SearchOptions& options, SearchMethod& args, ProbSpec::CSPInstance& instance,
-                      bool (*callback)(void))
+/*
+ * Each solve works through the thread-local 'globals', so solves on different
+ * threads are independent. The remaining process-wide state is handled here:
+ *
+ *  - Minion writes its output to cout. While any solve is running, cout is
+ *    replaced by a buffer which sends each thread's output to the log file of
+ *    the solve running on that thread.
+ *  - Time limits use a timer thread per solve, rather than a process-wide
+ *    alarm signal.
+ *  - Each solve has its own ParallelData, rather than one in shared memory.
+ */
+
+namespace {
+
+thread_local std::streambuf* threadLog = nullptr;
+
+class ThreadLogBuf : public std::streambuf {
+public:
+  std::streambuf* original = nullptr;
+
+protected:
+  std::streambuf* target()
+  {
+    return threadLog ? threadLog : original;
+  }
+
+  int overflow(int c) override
+  {
+    if(c == traits_type::eof()) {
+      return traits_type::not_eof(c);
+    }
+    return target()->sputc(traits_type::to_char_type(c));
+  }
+
+  std::streamsize xsputn(const char* s, std::streamsize n) override
+  {
+    return target()->sputn(s, n);
+  }
+
+  int sync() override
+  {
+    return target()->pubsync();
+  }
+};
+
+std::mutex threadLogLock;
+ThreadLogBuf threadLogBuf;
+int threadLogUsers = 0;
+
+// Sends cout on this thread to 'log', until destroyed.
+struct ThreadLogRedirect {
+  ThreadLogRedirect(std::streambuf* log)
+  {
+    std::lock_guard<std::mutex> guard(threadLogLock);
+    if(threadLogUsers++ == 0) {
+      threadLogBuf.original = cout.rdbuf(&threadLogBuf);
+    }
+    threadLog = log;
+  }
+
+  ~ThreadLogRedirect()
+  {
+    cout.flush();
+    threadLog = nullptr;
+    std::lock_guard<std::mutex> guard(threadLogLock);
+    if(--threadLogUsers == 0) {
+      cout.rdbuf(threadLogBuf.original);
+    }
+  }
+};
+
+// Sets 'trigger' once 'timeout' seconds have passed, unless destroyed first.
+class SolveAlarm {
+  std::mutex lock;
+  std::condition_variable finished;
+  bool done = false;
+  std::thread timer;
+
+public:
+  SolveAlarm(std::atomic<bool>* trigger, SysInt timeout)
+  {
+    *trigger = (timeout <= 0);
+    timer = std::thread([this, trigger, timeout]() {
+      std::unique_lock<std::mutex> l(lock);
+      if(!finished.wait_for(l, std::chrono::seconds(timeout), [this]() { return done; })) {
+        *trigger = true;
+      }
+    });
+  }
+
+  ~SolveAlarm()
+  {
+    {
+      std::lock_guard<std::mutex> l(lock);
+      done = true;
+    }
+    finished.notify_one();
+    timer.join();
+  }
+};
+
+// Opens the log file for a solve started at 'rawtime'.
+void openSolveLog(std::filebuf& log, time_t rawtime)
 {
-  std::lock_guard<std::mutex> guard(global_minion_lock);
-  ReturnCodes returnCode = ReturnCodes::OK;
+  stringstream filenameStream;
+  filenameStream << "minion";
+  filenameStream << put_time(gmtime(&rawtime), "%Y-%m-%d-%H:%M:%S");
+  filenameStream << ".log";
+
+  log.open(filenameStream.str(), ios_base::out | ios_base::app);
+}
 
+// Builds 'instance' using the current thread's 'globals', which must be
+// newly created, ready to be searched. Throws parse_exception if the instance
+// is invalid.
+ReturnCodes buildWithGlobals(SearchOptions& options, SearchMethod& args,
+                             ProbSpec::CSPInstance& instance, bool (*callback)(void),
+                             time_t rawtime)
+{
   /*
    * Adapted from minion_main.
    * Whereas minion_main takes in command line arguments, we take in Minion
    * objects.
    */
 
-  resetMinion();
+  // Forked and threaded search share process-wide state, so can't be used
+  // by solves which may be running at the same time.
+  if(options.parallel || options.threads > 0) {
+    cout << "Parallel and threaded search are not supported in library usage" << endl;
+    return ReturnCodes::UNSUPPORTED_OPTION;
+  }
 
-  // Redirect cout
-  // https://stackoverflow.com/questions/49462524/controlling-output-from-external-libraries
-  // https://stackoverflow.com/questions/4810516/c-redirecting-stdout
+  getState().getOldTimer().startClock();
+
+  globals->callback = callback;
+  globals->options_m = new SearchOptions(options);
+  globals->options_m->findAllSolutions();
+
+  getOptions().printLine("# " + std::string(MinionVersion));
+  getOptions().printLine("# Git version: \"" + tostring(GIT_VER) + "\"");
+
+  GET_GLOBAL(global_random_gen).seed(args.randomSeed);
+  if(!getOptions().silent) {
+    cout << "#  Run at: UTC " << asctime(gmtime(&rawtime)) << endl;
+    cout << "# Input filename: " << getOptions().instance_name << endl;
+    getOptions().printLine("Using seed: " + tostring(args.randomSeed));
+  }
+
+  finaliseModel(instance);
+
+  // Output graphs, stats, or redump (will not return in these cases)
+  infoDumps(instance);
+
+  // Copy args into tableout
+  getTableOut().set("RandomSeed", tostring(args.randomSeed));
+  getTableOut().set("Preprocess", tostring(args.preprocess));
+
+  getTableOut().set("MinionVersion", -1);
+  getTableOut().set("TimeOut", 0); // will be set to 1 if a timeout occurs.
+  getState().getOldTimer().maybePrintTimestepStore(cout, "Parsing Time: ", "ParsingTime",
+                                                   getTableOut(), !getOptions().silent);
+
+  SetupCSPOrdering(instance, args);
+  BuildCSP(instance);
+  return ReturnCodes::OK;
+}
+
+// Solves 'instance' using the current thread's 'globals', which must be
+// newly created.
+ReturnCodes solveWithGlobals(SearchOptions& options, SearchMethod& args,
+                             ProbSpec::CSPInstance& instance, bool (*callback)(void))
+{
+  ReturnCodes returnCode = ReturnCodes::OK;
 
-  streambuf* oldCoutStreamBuf = cout.rdbuf();
-  ifstream logOutStream;
   time_t rawtime;
   time(&rawtime);
 
-  stringstream filenameStream;
-  filenameStream << "minion";
-  filenameStream << put_time(gmtime(&rawtime), "%Y-%m-%d-%H:%M:%S");
-  filenameStream << ".log";
-
-  logOutStream.open(filenameStream.str(), ios_base::app);
+  std::filebuf logOut;
+  openSolveLog(logOut, rawtime);
+  ThreadLogRedirect redirect(&logOut);
 
-  cout.rdbuf(logOutStream.rdbuf());
+  Parallel::ParallelData parData{};
+  globals->parData_m = &parData;
 
   // Pass error codes across FFI boundaries, not exceptions.
   try {
+    // CPU time limits are treated as wall clock limits, as CPU time is only
+    // measured per process.
+    std::unique_ptr<SolveAlarm> alarm;
+    if(options.timeoutActive) {
+      alarm.reset(new SolveAlarm(&parData.alarmTrigger, options.time_limit));
+    }
 
-    // No parallel minion in library usage for now
-    //getParallelData();
+    returnCode = buildWithGlobals(options, args, instance, callback, rawtime);
 
-    getState().getOldTimer().startClock();
+    if(returnCode == ReturnCodes::OK) {
+      // TODO (nd60): how to replace this??
+      if(getOptions().commandlistIn != "") {
+        doCommandSearch(instance, args);
+      } else {
+        doStandardSearch(instance, args);
+      }
+    }
+  }
 
-    globals->callback = callback;
-    globals->options_m = new SearchOptions(options);
-    globals->options_m->findAllSolutions();
+  catch(const parse_exception& e) {
+    cout << "Invalid instance: " << e.what() << endl;
+    returnCode = ReturnCodes::INVALID_INSTANCE;
+  } catch(...) {
+    returnCode = ReturnCodes::UNKNOWN_ERROR;
+  }
 
-    getOptions().printLine("# " + std::string(MinionVersion));
-    getOptions().printLine("# Git version: \"" + tostring(GIT_VER) + "\"");
+  globals->parData_m = nullptr;
 
-    GET_GLOBAL(global_random_gen).seed(args.randomSeed);
-    if(!getOptions().silent) {
-      cout << "#  Run at: UTC " << asctime(gmtime(&rawtime)) << endl;
-      cout << "# Input filename: " << getOptions().instance_name << endl;
-      getOptions().printLine("Using seed: " + tostring(args.randomSeed));
-    }
+  return returnCode;
+}
 
-    Parallel::setupAlarm(getOptions().timeoutActive, getOptions().time_limit,
-                         getOptions().time_limit_is_CPUTime);
+} // namespace
 
-    finaliseModel(instance);
+ReturnCodes runMinion(SearchOptions& options, SearchMethod& args, ProbSpec::CSPInstance& instance,
+                      bool (*callback)(void))
+{
+  resetMinion();
+  return solveWithGlobals(options, args, instance, callback);
+}
 
-    // Output graphs, stats, or redump (will not return in these cases)
-    infoDumps(instance);
+/*********************************************************************/
+/*                          Solver contexts                          */
+/*********************************************************************/
 
-    // Copy args into tableout
-    getTableOut().set("RandomSeed", tostring(args.randomSeed));
-    getTableOut().set("Preprocess", tostring(args.preprocess));
+namespace {
 
-    getTableOut().set("MinionVersion", -1);
-    getTableOut().set("TimeOut", 0); // will be set to 1 if a timeout occurs.
-    getState().getOldTimer().maybePrintTimestepStore(cout, "Parsing Time: ", "ParsingTime",
-                                                     getTableOut(), !getOptions().silent);
+// Wraps a constraint added by minionContext_assumeConstraint. Minion can't
+// remove a constraint once it is set up, so when the solve which assumed it
+// is over the wrapper is switched off, and drops each of its triggers the next
+// time one is called.
+struct AssumedConstraint : public ParentConstraint {
+  bool active;
 
-    SetupCSPOrdering(instance, args);
-    BuildCSP(instance);
+  AssumedConstraint(AbstractConstraint* c) : ParentConstraint({c}), active(true) {}
 
-    // TODO (nd60): how to replace this??
-    if(getOptions().commandlistIn != "") {
-      doCommandSearch(instance, args);
+  virtual string constraintName() {
+    return "assumed";
+  }
+
+  virtual string extendedName() {
+    return constraintName() + ":" + child_constraints[0]->extendedName();
+  }
+
+  virtual string fullOutputName() {
+    return child_constraints[0]->fullOutputName();
+  }
+
+  virtual vector<AnyVarRef> getVars() {
+    return child_constraints[0]->getVars();
+  }
+
+  virtual BOOL checkAssignment(DomainInt* v, SysInt vSize) {
+    return !active || child_constraints[0]->checkAssignment(v, vSize);
+  }
+
+  virtual bool getSatisfyingAssignment(box<pair<SysInt, DomainInt>>& assignment) {
+    return child_constraints[0]->getSatisfyingAssignment(assignment);
+  }
+
+  virtual void fullPropagate() {
+    if(active) {
+      child_constraints[0]->fullPropagate();
+    }
+  }
+
+  virtual void propagateDynInt(SysInt trig, DomainDelta dd) {
+    if(active) {
+      passDynTriggerToChild(trig, dd);
     } else {
-      doStandardSearch(instance, args);
+      releaseTriggerInt(trig);
+    }
+  }
+};
+
+// Restricts the domain of a variable for one incremental solve.
+struct Assumption {
+  Var var;
+  DomainInt lower;
+  DomainInt upper;
+};
+
+} // namespace
+
+struct MinionContext {
+  Globals* globals = nullptr;
+  bool (*callback)(MinionContext*) = nullptr;
+
+  // Set by minionContext_setSolutionSink. Solutions are collected in
+  // 'solutionBuffer', row-major, and passed to the sink 'batchSize' at a time.
+  MinionSolutionSink sink = nullptr;
+  void* sinkData = nullptr;
+  size_t batchSize = 0;
+  size_t batchCount = 0;
+  vector<int> solutionBuffer;
+
+  // Collects the current solution, passing the batch to the sink once it is
+  // full. Returns false if the sink asked to stop.
+  bool collectSolution()
+  {
+    vector<vector<AnyVarRef>>& printMatrix = getState().getPrintMatrix();
+    for(vector<AnyVarRef>& row : printMatrix) {
+      for(AnyVarRef& v : row) {
+        solutionBuffer.push_back(checked_cast<int>(v.assignedValue()));
+      }
+    }
+    batchCount++;
+    if(batchCount == 1) {
+      solutionBuffer.reserve(batchSize * solutionBuffer.size());
+    }
+    if(batchCount < batchSize) {
+      return true;
     }
+    return flushSolutions();
+  }
 
+  // Passes any collected solutions to the sink.
+  bool flushSolutions()
+  {
+    if(batchCount == 0) {
+      return true;
+    }
+    size_t width = solutionBuffer.size() / batchCount;
+    bool carryOn = sink(this, solutionBuffer.data(), batchCount, width, sinkData);
+    solutionBuffer.clear();
+    batchCount = 0;
+    return carryOn;
   }
 
-  catch(parse_exception e) {
+  // The rest is only used by incremental solving, after minionContext_build.
+  ProbSpec::CSPInstance* instance = nullptr;
+  SearchMethod args;
+  Parallel::ParallelData parData{};
+  std::filebuf log;
+
+  // Assumptions for the next call to minionContext_solve.
+  vector<Assumption> assumptions;
+  vector<ConstraintBlob> assumedBlobs;
+
+  // Every constraint assumed since the model was built. They can't be freed
+  // before the globals, as the trigger lists may still refer to them.
+  vector<AssumedConstraint*> assumedConstraints;
+};
+
+namespace {
+
+// The context whose solve is running on this thread.
+thread_local MinionContext* runningContext = nullptr;
+
+bool contextCallback()
+{
+  MinionContext* context = runningContext;
+  if(context->callback && !context->callback(context)) {
+    return false;
+  }
+  return !context->sink || context->collectSolution();
+}
+
+// The callback to give Minion for a solve in 'context'.
+bool (*contextSolutionHandler(MinionContext* context))(void)
+{
+  return (context->callback || context->sink) ? contextCallback : NULL;
+}
+
+// Makes 'context' the current one on this thread, until destroyed.
+struct UseContext {
+  Globals* oldGlobals;
+  MinionContext* oldContext;
+
+  UseContext(MinionContext* context) : oldGlobals(globals), oldContext(runningContext)
+  {
+    globals = context->globals;
+    runningContext = context;
+  }
+
+  ~UseContext()
+  {
+    globals = oldGlobals;
+    runningContext = oldContext;
+  }
+};
+
+// Replaces the state in 'context' with a newly created one.
+void resetContext(MinionContext* context)
+{
+  {
+    UseContext use(context);
+    for(AssumedConstraint* c : context->assumedConstraints) {
+      delete c;
+    }
+  }
+  context->assumedConstraints.clear();
+  context->solutionBuffer.clear();
+  context->batchCount = 0;
+  context->assumptions.clear();
+  context->assumedBlobs.clear();
+  context->instance = nullptr;
+  if(context->log.is_open()) {
+    context->log.close();
+  }
+
+  delete context->globals;
+  context->globals = new Globals();
+}
+
+// Applies the assumptions in 'context' to the current state, propagating
+// each one as it goes. Stops early if the state fails.
+void applyAssumptions(MinionContext* context)
+{
+  for(const Assumption& a : context->assumptions) {
+    if(getState().isFailed()) {
+      return;
+    }
+    AnyVarRef v = getAnyVarRefFromVar(a.var);
+    v.setMin(a.lower);
+    v.setMax(a.upper);
+  }
+
+  for(ConstraintBlob& blob : context->assumedBlobs) {
+    if(getState().isFailed()) {
+      return;
+    }
+    AssumedConstraint* c = new AssumedConstraint(build_constraint(blob));
+    context->assumedConstraints.push_back(c);
+    c->setup();
+    c->fullPropagate();
+    c->fullPropagateDone = true;
+  }
+
+  if(!getState().isFailed()) {
+    getQueue().propagateQueue();
+  }
+}
+
+} // namespace
+
+MinionContext* minionContext_new()
+{
+  MinionContext* context = new MinionContext();
+  context->globals = new Globals();
+  return context;
+}
+
+void minionContext_free(MinionContext* context)
+{
+  resetContext(context);
+  delete context->globals;
+  delete context;
+}
+
+ReturnCodes minionContext_run(MinionContext* context, SearchOptions& options, SearchMethod& args,
+                              ProbSpec::CSPInstance& instance,
+                              bool (*callback)(MinionContext*))
+{
+  resetContext(context);
+  context->callback = callback;
+
+  UseContext use(context);
+  ReturnCodes returnCode = solveWithGlobals(options, args, instance, contextSolutionHandler(context));
+  if(context->sink) {
+    context->flushSolutions();
+  }
+  return returnCode;
+}
+
+ReturnCodes minionContext_build(MinionContext* context, SearchOptions& options, SearchMethod& args,
+                                ProbSpec::CSPInstance& instance)
+{
+  resetContext(context);
+
+  time_t rawtime;
+  time(&rawtime);
+  openSolveLog(context->log, rawtime);
+
+  UseContext use(context);
+  ThreadLogRedirect redirect(&context->log);
+  globals->parData_m = &context->parData;
+
+  ReturnCodes returnCode = ReturnCodes::OK;
+  try {
+    returnCode = buildWithGlobals(options, args, instance, NULL, rawtime);
+    if(returnCode == ReturnCodes::OK) {
+      // Later solves start from this propagated state. If it fails, every
+      // solve finds no solutions.
+      if(!PreprocessCSP(instance, args)) {
+        getState().setFailed();
+      }
+      context->instance = &instance;
+      context->args = args;
+    }
+  } catch(const parse_exception& e) {
     cout << "Invalid instance: " << e.what() << endl;
     returnCode = ReturnCodes::INVALID_INSTANCE;
   } catch(...) {
     returnCode = ReturnCodes::UNKNOWN_ERROR;
   }
 
-  Parallel::endParallelMinion();
+  globals->parData_m = nullptr;
+  return returnCode;
+}
+
+void minionContext_assumeValue(MinionContext* context, Var var, int value)
+{
+  context->assumptions.push_back(Assumption{var, value, value});
+}
+
+void minionContext_assumeBounds(MinionContext* context, Var var, int lower, int upper)
+{
+  context->assumptions.push_back(Assumption{var, lower, upper});
+}
+
+void minionContext_assumeConstraint(MinionContext* context, ConstraintBlob& constraint)
+{
+  context->assumedBlobs.push_back(constraint);
+}
+
+void minionContext_clearAssumptions(MinionContext* context)
+{
+  context->assumptions.clear();
+  context->assumedBlobs.clear();
+}
+
+ReturnCodes minionContext_solve(MinionContext* context, bool (*callback)(MinionContext*))
+{
+  if(context->instance == nullptr) {
+    return ReturnCodes::INVALID_INSTANCE;
+  }
+
+  context->callback = callback;
+
+  UseContext use(context);
+  ThreadLogRedirect redirect(&context->log);
+  globals->parData_m = &context->parData;
+  globals->callback = contextSolutionHandler(context);
+
+  ReturnCodes returnCode = ReturnCodes::OK;
+  size_t firstAssumed = context->assumedConstraints.size();
+  bool rootFailed = getState().isFailed();
+  SysInt depth = Controller::getWorldDepth();
+
+  try {
+    std::unique_ptr<SolveAlarm> alarm;
+    if(getOptions().timeoutActive) {
+      alarm.reset(new SolveAlarm(&context->parData.alarmTrigger, getOptions().time_limit));
+    }
+
+    getState().resetSearchCounters();
+    getState().setOptimiseValue(vector<DomainInt>{});
+    getTableOut().set("TimeOut", 0);
+
+    // Assumptions go on a new level, so popping it returns to the root state.
+    if(!rootFailed) {
+      Controller::worldPush();
+      applyAssumptions(context);
+    }
+
+    SolveCSP(*context->instance, context->args);
+
+    getOptions().printLine("Solutions Found: " + tostring(getState().getSolutionCount()));
+    getTableOut().set("Nodes", tostring(getState().getNodeCount()));
+    getTableOut().set("Satisfiable", (getState().getSolutionCount() == 0 ? 0 : 1));
+    getTableOut().set("SolutionsFound", getState().getSolutionCount());
+  } catch(const parse_exception& e) {
+    cout << "Invalid assumption: " << e.what() << endl;
+    returnCode = ReturnCodes::INVALID_INSTANCE;
+  } catch(...) {
+    returnCode = ReturnCodes::UNKNOWN_ERROR;
+  }
 
-  // Restore old cout
-  cout.rdbuf(oldCoutStreamBuf);
+  if(!rootFailed) {
+    Controller::worldPopToDepth(depth);
+  }
+  for(size_t i = firstAssumed; i < context->assumedConstraints.size(); ++i) {
+    context->assumedConstraints[i]->active = false;
+  }
+  minionContext_clearAssumptions(context);
+  if(context->sink) {
+    context->flushSolutions();
+  }
 
+  globals->parData_m = nullptr;
   return returnCode;
 }
 
+void minionContext_setSolutionSink(MinionContext* context, MinionSolutionSink sink,
+                                   size_t batchSize, void* userData)
+{
+  context->sink = sink;
+  context->sinkData = userData;
+  context->batchSize = std::max(batchSize, (size_t)1);
+  context->solutionBuffer.clear();
+  context->batchCount = 0;
+}
+
+int minionContext_printMatrixGetValue(MinionContext* context, int idx)
+{
+  UseContext use(context);
+  return printMatrix_getValue(idx);
+}
+
+char* minionContext_tableOutGet(MinionContext* context, char* key)
+{
+  UseContext use(context);
+  return TableOut_get(key);
+}
+
 /*********************************************************************/
 /*                    Instance building functions                    */
 /*********************************************************************/
@@ -130,6 +130,7 @@ enum ReturnCodes
 {
   OK,
   INVALID_INSTANCE,
+  UNSUPPORTED_OPTION,
   UNKNOWN_ERROR = 255
 };
 
@@ -139,13 +140,150 @@ enum ReturnCodes
  *   Run Minion.
  *
  *   Minion is reset on each invokation of this function, so it is safe to call
- *   sequentially.
+ *   sequentially. Each thread has its own copy of Minion, so different threads
+ *   can call this at the same time, as long as they use different instances.
+ *
+ *   Parallel (-parallel) and threaded (-threads) search are not supported,
+ *   and return UNSUPPORTED_OPTION. CPU time limits are treated as wall clock
+ *   time limits.
  *
  *   An error code is returned. These are described in ReturnCodes.
  */
 ReturnCodes runMinion(SearchOptions& options, SearchMethod& args, ProbSpec::CSPInstance& instance,
                       bool (*callback)(void));
 
+/* SOLVER CONTEXTS
+ * ===============
+ *
+ * A MinionContext holds one copy of all of Minion's state (its memory, search
+ * state, queues, variables and random number generator). Solves in
+ * different contexts are independent, so a context can be created for each
+ * request, and many solved at once on a pool of threads. A context can be
+ * used by any thread, but only by one thread at a time.
+ *
+ * Instances solved at the same time must not share TupleLists, as Minion
+ * caches data in them during a solve.
+ */
+struct MinionContext;
+
+/// Creates a new `MinionContext`.
+///
+/// Memory Management:
+///   The caller owns the returned pointer, and frees it with
+///   `minionContext_free`.
+MinionContext* minionContext_new();
+
+/// Frees the given `MinionContext`.
+void minionContext_free(MinionContext* context);
+
+/*
+ * ReturnCodes minionContext_run:
+ *
+ *   Like runMinion, but runs in `context`, which is reset first.
+ *
+ *   `callback`, if not NULL, is called with `context` on each solution. As in
+ *   runMinion, returning false stops search.
+ */
+ReturnCodes minionContext_run(MinionContext* context, SearchOptions& options, SearchMethod& args,
+                              ProbSpec::CSPInstance& instance,
+                              bool (*callback)(MinionContext*));
+
+/*
+ * SOLUTION SINKS
+ * ==============
+ *
+ * Reading each value of each solution back through
+ * minionContext_printMatrixGetValue is slow when there are many solutions.
+ * Instead, a context can be given a sink, which is passed solutions in
+ * batches:
+ *
+ *   bool sink(MinionContext* context, const int* values, size_t count,
+ *             size_t width, void* userData);
+ *
+ * `values` holds `count` solutions, one after another. Each solution is
+ * `width` values, the print matrix in order. `values` is only valid until the
+ * sink returns, so must be copied if it is needed later.
+ *
+ * The sink is called whenever `batchSize` solutions have been found, and
+ * once more at the end of a solve for any left over. Search waits while the
+ * sink runs, and stops if it returns false.
+ */
+typedef bool (*MinionSolutionSink)(MinionContext* context, const int* values, size_t count,
+                                   size_t width, void* userData);
+
+/// Passes the solutions found by later solves in `context` to `sink`, in
+/// batches of `batchSize`, along with `userData`. A NULL `sink` stops
+/// solutions being passed to any sink. Solutions are passed to the sink as
+/// well as the callback given to the solve.
+void minionContext_setSolutionSink(MinionContext* context, MinionSolutionSink sink,
+                                   size_t batchSize, void* userData);
+
+/// Like `printMatrix_getValue`, for a solution found in `context`. Should
+/// only be called from the callback of `minionContext_run`.
+int minionContext_printMatrixGetValue(MinionContext* context, int idx);
+
+/// Like `TableOut_get`, for the last solve in `context`.
+///
+/// Memory Management:
+///   The returned pointer must be freed by the user.
+char* minionContext_tableOutGet(MinionContext* context, char* key);
+
+/* INCREMENTAL SOLVING
+ * ===================
+ *
+ * A context can also build a model once, then solve it many times under
+ * different assumptions. Each solve starts from the propagated state of the
+ * model at the root, so doesn't rebuild any constraints:
+ *
+ *   MinionContext* context = minionContext_new();
+ *   minionContext_build(context, options, args, instance);
+ *
+ *   minionContext_assumeValue(context, x, 2);
+ *   minionContext_solve(context, callback);  // solves with x = 2
+ *
+ *   minionContext_assumeBounds(context, y, 1, 3);
+ *   minionContext_assumeConstraint(context, extra);
+ *   minionContext_solve(context, callback);  // solves with y in 1..3 and extra
+ *
+ * Assumptions only last for the next call to minionContext_solve. The
+ * instance must not be changed or freed while the context is using it.
+ *
+ * Assumed constraints are built on each solve, and the memory for them is
+ * only freed when the context is next built, or freed.
+ */
+
+/// Builds `instance` in `context`, which is reset first, and propagates it
+/// ready for minionContext_solve. Returns UNSUPPORTED_OPTION for the same
+/// options as runMinion.
+ReturnCodes minionContext_build(MinionContext* context, SearchOptions& options, SearchMethod& args,
+                                ProbSpec::CSPInstance& instance);
+
+/// Assumes `var` = `value` in the next solve of `context`.
+void minionContext_assumeValue(MinionContext* context, Var var, int value);
+
+/// Assumes `lower` <= `var` <= `upper` in the next solve of `context`.
+void minionContext_assumeBounds(MinionContext* context, Var var, int lower, int upper);
+
+/// Adds `constraint` to the next solve of `context` only. The constraint is
+/// copied, so can be freed once this returns.
+void minionContext_assumeConstraint(MinionContext* context, ConstraintBlob& constraint);
+
+/// Removes all assumptions made since the last solve of `context`.
+void minionContext_clearAssumptions(MinionContext* context);
+
+/*
+ * ReturnCodes minionContext_solve:
+ *
+ *   Solves the model built by minionContext_build under the current
+ *   assumptions, which are then cleared. Statistics about the solve (such as
+ *   "SolutionsFound" and "Nodes") can be read with minionContext_tableOutGet.
+ *
+ *   `callback` is used as in minionContext_run.
+ *
+ *   Returns INVALID_INSTANCE if no model has been built in `context`.
+ */
+ReturnCodes minionContext_solve(MinionContext* context, bool (*callback)(MinionContext*));
+
 /*
  * void newVar:
  *
@@ -436,7 +574,8 @@ void vec_vec_int_free(std::vector<std::vector<DomainInt>>* vec);
 /* These functions access the TableOut: a logging class used to store
  * run statistics about Minion.
  *
- * TableOut is a global singleton.
+ * Each thread (and each MinionContext) has its own TableOut, which holds
+ * the results of its last solve.
  *
  *
  * Useful Values
@@ -36,4 +36,8 @@ public:
   void add(Backtrackable* bt_obj) {
     things.push_back(bt_obj);
   }
+
+  void remove(Backtrackable* bt_obj) {
+    things.erase(std::remove(things.begin(), things.end(), bt_obj), things.end());
+  }
 };
@@ -6,20 +6,67 @@
 
 #include "../system/system.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// A set of bits, packed 64 to a word, which (during search) can only be
+// removed from. A set bit means the element is a member.
+// The trail stores each changed word with its previous contents, so undo is
+// one word copy per change however many bits a change covered.
 class TrailedMonotonicSet {
-  vector<char> data;
+  typedef uint64_t word_type;
+  static const SysInt word_bits = 64;
+
+  vector<word_type> data;
 
-  vector<SysInt> trailstack;
+  SysInt bitCount;
+
+  vector<pair<SysInt, word_type>> trailstack;
 
   vector<SysInt> trailstack_marks;
 
+  static SysInt lowestBit(word_type w) {
+    D_ASSERT(w != 0);
+#ifdef _MSC_VER
+    unsigned long pos;
+    _BitScanForward64(&pos, w);
+    return pos;
+#else
+    return __builtin_ctzll(w);
+#endif
+  }
+
+  static SysInt highestBit(word_type w) {
+    D_ASSERT(w != 0);
+#ifdef _MSC_VER
+    unsigned long pos;
+    _BitScanReverse64(&pos, w);
+    return pos;
+#else
+    return word_bits - 1 - __builtin_clzll(w);
+#endif
+  }
+
+  static SysInt bitCountOf(word_type w) {
+#ifdef _MSC_VER
+    return (SysInt)__popcnt64(w);
+#else
+    return __builtin_popcountll(w);
+#endif
+  }
+
+  static word_type bitMask(SysInt i) {
+    return (word_type)1 << (i % word_bits);
+  }
+
 public:
-  TrailedMonotonicSet() {
+  TrailedMonotonicSet() : bitCount(0) {
     trailstack_marks.push_back(0);
   }
 
   DomainInt size() const {
-    return data.size();
+    return bitCount;
   }
 
   void undo() {
@@ -29,8 +76,8 @@ public:
     trailstack_marks.pop_back();
 
     for(; i >= j; i--) {
-      D_ASSERT(!data[trailstack[i]]);
-      data[trailstack[i]] = true;
+      D_ASSERT((data[trailstack[i].first] & trailstack[i].second) == data[trailstack[i].first]);
+      data[trailstack[i].first] = trailstack[i].second;
       trailstack.pop_back();
     }
     D_ASSERT((SysInt)trailstack.size() == j);
@@ -38,24 +85,87 @@ public:
 
   bool ifMember_remove(DomainInt index) {
     SysInt i = checked_cast<SysInt>(index);
-    if(data[i]) {
-      data[i] = false;
-      trailstack.push_back(i);
+    D_ASSERT(i >= 0 && i < bitCount);
+    word_type& w = data[i / word_bits];
+    if(w & bitMask(i)) {
+      trailstack.push_back(make_pair(i / word_bits, w));
+      w &= ~bitMask(i);
       return true;
     }
     return false;
   }
 
-  bool isMember(DomainInt index) {
+  bool isMember(DomainInt index) const {
     SysInt i = checked_cast<SysInt>(index);
-    return data[i];
+    D_ASSERT(i >= 0 && i < bitCount);
+    return (data[i / word_bits] & bitMask(i)) != 0;
   }
 
   void unchecked_remove(DomainInt index) {
     SysInt i = checked_cast<SysInt>(index);
-    D_ASSERT(data[i]);
-    data[i] = false;
-    trailstack.push_back(i);
+    D_ASSERT(isMember(i));
+    word_type& w = data[i / word_bits];
+    trailstack.push_back(make_pair(i / word_bits, w));
+    w &= ~bitMask(i);
+  }
+
+  /// Returns the smallest member in [from, to], or to + 1 if there is none.
+  DomainInt nextMember(DomainInt from, DomainInt to) const {
+    if(from > to)
+      return to + 1;
+    SysInt i = checked_cast<SysInt>(from);
+    SysInt last = checked_cast<SysInt>(to);
+    D_ASSERT(i >= 0 && last < bitCount);
+    SysInt word = i / word_bits;
+    SysInt lastWord = last / word_bits;
+    // Mask off the bits below 'from' in the first word.
+    word_type w = data[word] & (~(word_type)0 << (i % word_bits));
+    while(w == 0) {
+      if(word == lastWord)
+        return to + 1;
+      w = data[++word];
+    }
+    SysInt found = word * word_bits + lowestBit(w);
+    return (found <= last) ? DomainInt(found) : to + 1;
+  }
+
+  /// Returns the largest member in [from, to], or from - 1 if there is none.
+  DomainInt prevMember(DomainInt from, DomainInt to) const {
+    if(from > to)
+      return from - 1;
+    SysInt first = checked_cast<SysInt>(from);
+    SysInt i = checked_cast<SysInt>(to);
+    D_ASSERT(first >= 0 && i < bitCount);
+    SysInt word = i / word_bits;
+    SysInt firstWord = first / word_bits;
+    // Mask off the bits above 'to' in the last word.
+    word_type w = data[word] & (~(word_type)0 >> (word_bits - 1 - i % word_bits));
+    while(w == 0) {
+      if(word == firstWord)
+        return from - 1;
+      w = data[--word];
+    }
+    SysInt found = word * word_bits + highestBit(w);
+    return (found >= first) ? DomainInt(found) : from - 1;
+  }
+
+  /// Returns the number of members in [from, to].
+  DomainInt countMembers(DomainInt from, DomainInt to) const {
+    if(from > to)
+      return 0;
+    SysInt first = checked_cast<SysInt>(from);
+    SysInt last = checked_cast<SysInt>(to);
+    D_ASSERT(first >= 0 && last < bitCount);
+    SysInt firstWord = first / word_bits;
+    SysInt lastWord = last / word_bits;
+    word_type lowMask = ~(word_type)0 << (first % word_bits);
+    word_type highMask = ~(word_type)0 >> (word_bits - 1 - last % word_bits);
+    if(firstWord == lastWord)
+      return bitCountOf(data[firstWord] & lowMask & highMask);
+    SysInt count = bitCountOf(data[firstWord] & lowMask);
+    for(SysInt word = firstWord + 1; word < lastWord; ++word)
+      count += bitCountOf(data[word]);
+    return count + bitCountOf(data[lastWord] & highMask);
   }
 
   void before_branch_left() {
@@ -71,8 +181,11 @@ public:
   {}
 
   DomainInt request_storage(DomainInt allocsize) {
-    SysInt i = data.size();
-    data.resize(i + checked_cast<SysInt>(allocsize), true);
+    SysInt i = bitCount;
+    bitCount += checked_cast<SysInt>(allocsize);
+    // Unused bits at the end of the last word are always left set, so they
+    // are already correct when they are handed out.
+    data.resize((bitCount + word_bits - 1) / word_bits, ~(word_type)0);
     return i;
   }
 };
@@ -32,10 +32,6 @@ void print_default_help(char** argv) {
       "on";
 #endif
 
-#ifdef WDEG
-  cout << " and wdeg on";
-#endif
-
   cout << endl;
 }
 
@@ -65,6 +61,9 @@ void doStandardSearch(CSPInstance& instance, SearchMethod args) {
   getTableOut().set("Satisfiable", (getState().getSolutionCount() == 0 ? 0 : 1));
   getTableOut().set("SolutionsFound", getState().getSolutionCount());
 
+  if(getOptions().propProfile)
+    printPropProfile();
+
   if(getOptions().tableout && !Parallel::isAChildProcess()) {
     getTableOut().print_line(); // Outputs a line to the table file.
   }
@@ -79,6 +78,8 @@ int minion_main(int argc, char** argv) {
   // Wrap main in a try/catch just to stop exceptions leaving main,
   // as windows gets really annoyed when that happens.
   try {
+    // Worker threads of a threaded search create their own Globals.
+    globals = new Globals();
 
     // Force parallel data to be created
     getParallelData();
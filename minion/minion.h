@@ -37,7 +37,6 @@ static const char MinionVersion[] = "Minion Version 2";
 
 #include "get_info/get_info.h"
 #include "solver.h"
-VARDEF(ofstream solsoutfile);
 
 #include "memory_management/MemoryBlock.h"
 
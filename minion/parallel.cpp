@@ -4,6 +4,7 @@
 #include "minion.h"
 
 #include "parallel/parallel.h"
+#include "search/common_search.h"
 
 // Disable on windows
 #ifndef _WIN32
@@ -11,10 +12,67 @@
 #endif
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <signal.h>
+#include <thread>
 
 namespace Parallel {
 
+// The work owned by one worker of a threaded search.
+struct ThreadWorker {
+  std::mutex lock;
+  // Subtrees split off this worker's search. The worker takes work from the
+  // back (the most recent split, deepest in the tree), while other workers
+  // steal from the front (the oldest split, highest in the tree).
+  std::deque<std::vector<Controller::triple>> work;
+  // Size of 'work', which can be read without taking 'lock'.
+  std::atomic<int> queued{0};
+};
+
+// Shared by all the workers of a threaded search.
+struct ThreadPool {
+  std::vector<std::unique_ptr<ThreadWorker>> threadWorkers;
+
+  std::mutex lock;
+  std::condition_variable workReady;
+  // Workers which have joined the search, and how many are waiting for work.
+  int workers = 0;
+  int idle = 0;
+  bool finished = false;
+  // Number of idle workers which failed to steal any work.
+  std::atomic<int> hungry{0};
+  std::atomic<bool> stopped{false};
+
+  // Protects solution output, and the solution count.
+  std::recursive_mutex outputLock;
+  long long solutions = 0;
+
+  // Take the oldest subtree from some worker, trying each worker in turn,
+  // starting after 'thread'. Must be called holding 'lock'.
+  bool steal(int thread, std::vector<Controller::triple>& prefix) {
+    for(size_t i = 1; i <= threadWorkers.size(); ++i) {
+      ThreadWorker& victim = *threadWorkers[(thread + i) % threadWorkers.size()];
+      std::lock_guard<std::mutex> l(victim.lock);
+      if(!victim.work.empty()) {
+        prefix = std::move(victim.work.front());
+        victim.work.pop_front();
+        victim.queued--;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+static ThreadPool* threadPool = nullptr;
+// The last version of the shared bound this thread has seen.
+static thread_local long long seenBoundVersion = 0;
+// The number of the current thread in a threaded search.
+static thread_local int threadNumber = -1;
+
 static bool checkIsAChildProcess;
 static bool forkEverCalled;
 
@@ -54,6 +112,177 @@ void setupAlarm(bool alarmActive, SysInt timeout, bool CPUTime) {
   activateTrigger(&(getParallelData().alarmTrigger), alarmActive, timeout, CPUTime);
 }
 
+void publishBound(const std::vector<DomainInt>& bound) {
+  if(!getOptions().parallel && !isThreadedSearch())
+    return;
+  // Larger objectives are not shared, but are still found by each search.
+  if(bound.size() > ParallelData::maxBoundSize)
+    return;
+
+  lockSolsout();
+  ParallelData& pd = getParallelData();
+  if(bound > std::vector<DomainInt>(pd.bound, pd.bound + pd.boundSize)) {
+    std::copy(bound.begin(), bound.end(), pd.bound);
+    pd.boundSize = bound.size();
+    pd.boundVersion++;
+  }
+  unlockSolsout();
+}
+
+bool boundChanged() {
+  return (getOptions().parallel || isThreadedSearch()) &&
+         getParallelData().boundVersion.load(std::memory_order_relaxed) != seenBoundVersion;
+}
+
+std::vector<DomainInt> getBound() {
+  lockSolsout();
+  ParallelData& pd = getParallelData();
+  std::vector<DomainInt> bound(pd.bound, pd.bound + pd.boundSize);
+  seenBoundVersion = pd.boundVersion;
+  unlockSolsout();
+  return bound;
+}
+
+bool isThreadedSearch() {
+  return threadPool != nullptr;
+}
+
+void runThreadedSearch(int threads, std::function<void(int)> worker) {
+  ThreadPool pool;
+  for(int i = 0; i < threads; ++i) {
+    pool.threadWorkers.push_back(std::unique_ptr<ThreadWorker>(new ThreadWorker()));
+  }
+  // The main thread starts with the whole search.
+  pool.threadWorkers[0]->work.push_back(std::vector<Controller::triple>());
+  pool.threadWorkers[0]->queued = 1;
+  threadPool = &pool;
+
+  Globals* mainGlobals = globals;
+  std::vector<long long> nodes(threads), solutions(threads);
+  std::vector<std::thread> workerThreads;
+  for(int i = 1; i < threads; ++i) {
+    // Give each worker a different, but reproducible, random seed.
+    std::mt19937 seeder = mainGlobals->global_random_gen;
+    unsigned seed = seeder() + i;
+    workerThreads.push_back(std::thread([&, i, seed]() {
+      globals = new Globals();
+      globals->options_m = new SearchOptions(*mainGlobals->options_m);
+      globals->parData_m = mainGlobals->parData_m;
+      globals->solsoutfile = mainGlobals->solsoutfile;
+      globals->global_random_gen.seed(seed);
+      // Like child processes of parallel search, only the main thread
+      // prints information about the search.
+      getOptions().silent = true;
+
+      worker(i);
+
+      nodes[i] = getState().getNodeCount();
+      solutions[i] = getState().getSolutionCount();
+      delete globals;
+      globals = nullptr;
+    }));
+  }
+
+  worker(0);
+
+  for(auto& t : workerThreads) {
+    t.join();
+  }
+  threadPool = nullptr;
+
+  for(int i = 1; i < threads; ++i) {
+    getState().incrementNodeCount(nodes[i]);
+    getState().incrementSolutionCount(solutions[i]);
+  }
+}
+
+void joinThreadedSearch(int thread) {
+  threadNumber = thread;
+  std::lock_guard<std::mutex> l(threadPool->lock);
+  threadPool->workers++;
+}
+
+bool getThreadWork(std::vector<Controller::triple>& prefix) {
+  ThreadPool& pool = *threadPool;
+  // First continue with work split off our own search.
+  {
+    ThreadWorker& self = *pool.threadWorkers[threadNumber];
+    std::lock_guard<std::mutex> l(self.lock);
+    if(!self.work.empty() && !pool.stopped) {
+      prefix = std::move(self.work.back());
+      self.work.pop_back();
+      self.queued--;
+      return true;
+    }
+  }
+
+  std::unique_lock<std::mutex> l(pool.lock);
+  pool.idle++;
+  while(true) {
+    if(pool.stopped) {
+      pool.finished = true;
+    }
+    if(!pool.finished && pool.steal(threadNumber, prefix)) {
+      pool.idle--;
+      return true;
+    }
+    // Once every worker is idle, there is nobody left to create work.
+    if(pool.idle == pool.workers) {
+      pool.finished = true;
+    }
+    if(pool.finished) {
+      pool.workReady.notify_all();
+      return false;
+    }
+    // Busy workers split their search when they see we are hungry.
+    pool.hungry++;
+    pool.workReady.wait(l);
+    pool.hungry--;
+  }
+}
+
+bool threadsWantWork() {
+  // Only split our search if there is nothing left to steal from us.
+  return threadPool && threadPool->hungry.load(std::memory_order_relaxed) > 0 &&
+         threadPool->threadWorkers[threadNumber]->queued.load(std::memory_order_relaxed) == 0;
+}
+
+void donateThreadWork(const std::vector<Controller::triple>& prefix) {
+  ThreadWorker& self = *threadPool->threadWorkers[threadNumber];
+  {
+    std::lock_guard<std::mutex> l(self.lock);
+    self.work.push_back(prefix);
+    self.queued++;
+  }
+  std::lock_guard<std::mutex> l(threadPool->lock);
+  threadPool->workReady.notify_one();
+}
+
+void stopThreadedSearch() {
+  threadPool->stopped = true;
+  std::lock_guard<std::mutex> l(threadPool->lock);
+  threadPool->workReady.notify_all();
+}
+
+bool threadedSearchStopped() {
+  return threadPool && threadPool->stopped;
+}
+
+bool claimThreadSolution() {
+  if(!threadPool) {
+    return true;
+  }
+  if(threadPool->stopped) {
+    return false;
+  }
+  threadPool->solutions++;
+  // Note that sollimit = -1 if all solutions should be found.
+  if(threadPool->solutions == getOptions().sollimit) {
+    stopThreadedSearch();
+  }
+  return true;
+}
+
 } // namespace Parallel
 
 #ifdef PARALLEL
@@ -70,12 +299,16 @@ namespace Parallel {
 void lockSolsout() {
   if(getOptions().parallel) {
     pthread_mutex_lock(&(getParallelData().outputLock));
+  } else if(threadPool) {
+    threadPool->outputLock.lock();
   }
 }
 
 void unlockSolsout() {
   if(getOptions().parallel) {
     pthread_mutex_unlock(&(getParallelData().outputLock));
+  } else if(threadPool) {
+    threadPool->outputLock.unlock();
   }
 }
 
@@ -102,6 +335,7 @@ ParallelData* setupParallelData() {
     pthread_mutexattr_t mutexAttr ;
     pthread_mutexattr_init(&mutexAttr);
     pthread_mutexattr_setpshared(&mutexAttr, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_settype(&mutexAttr, PTHREAD_MUTEX_RECURSIVE);
     if(pthread_mutex_init(&(pd->outputLock), &mutexAttr) < 0) {
       D_FATAL_ERROR("Setup outputLock mutex fail");
     }
@@ -206,9 +440,15 @@ void endParallelMinion() {
 namespace Parallel {
 
 void lockSolsout() {
+  if(threadPool) {
+    threadPool->outputLock.lock();
+  }
 }
 
 void unlockSolsout() {
+  if(threadPool) {
+    threadPool->outputLock.unlock();
+  }
 }
 
 void setNumberCores(int cores) {
@@ -5,6 +5,12 @@
 #define _PARALLEL_H_RQEUOERFOUJFDNJLFD
 
 #include <atomic>
+#include <functional>
+#include <vector>
+
+namespace Controller {
+struct triple;
+}
 
 namespace Parallel {
 struct ParallelData {
@@ -22,12 +28,29 @@ struct ParallelData {
   std::atomic<long long> children;
   std::atomic<bool> ctrlCPressed;
   std::atomic<bool> alarmTrigger;
+
+  // The best bound on the optimisation variables found by any process or
+  // thread, and how many times it has improved. Protected by lockSolsout.
+  static const int maxBoundSize = 16;
+  std::atomic<long long> boundVersion;
+  int boundSize;
+  DomainInt bound[maxBoundSize];
 };
 
 void setNumberCores(int cores);
 ParallelData* setupParallelData();
+// The solution output lock may be taken again by a thread which holds it.
 void lockSolsout();
 void unlockSolsout();
+
+struct SolsoutLock {
+  SolsoutLock() {
+    lockSolsout();
+  }
+  ~SolsoutLock() {
+    unlockSolsout();
+  }
+};
 bool shouldDoFork();
 int doFork();
 bool isAChildProcess();
@@ -35,6 +58,59 @@ bool isCtrlCPressed();
 bool isAlarmActivated();
 void setupAlarm(bool alarmActive, SysInt timeout, bool CPUTime);
 void endParallelMinion();
+
+/// Share a new bound on the optimisation variables (which must all be at
+/// least 'bound', in lexicographic order) with other processes or threads.
+void publishBound(const std::vector<DomainInt>& bound);
+
+/// Has another process or thread published a new bound since we last
+/// looked? Called at every search node, so cheap.
+bool boundChanged();
+
+/// The best bound published so far.
+std::vector<DomainInt> getBound();
+
+// Threaded search (-threads). Unlike the fork based search above, every
+// worker runs in this process, with its own Globals. Work is passed between
+// workers as a list of branching decisions from the root of search. Each
+// worker keeps a deque of subtrees split off its own search, which idle
+// workers steal from.
+
+/// Is a threaded search running?
+bool isThreadedSearch();
+
+/// Run 'worker' on 'threads' threads (including the current one), each
+/// with its own Globals, and wait for them all to finish. 'worker' is
+/// passed the number of the thread it is running on, where the current
+/// thread is thread 0.
+void runThreadedSearch(int threads, std::function<void(int)> worker);
+
+/// Called by worker 'thread' once it is ready to search. Afterwards, the
+/// worker should keep calling getThreadWork until it returns false.
+void joinThreadedSearch(int thread);
+
+/// Get a subtree to search, either from this worker's own deque or stolen
+/// from another worker, waiting if there is none. Returns false once the
+/// whole search is finished.
+bool getThreadWork(std::vector<Controller::triple>& prefix);
+
+/// Should this worker split its search, because other workers are waiting
+/// and there is nothing left to steal from it? Called at every search node,
+/// so cheap.
+bool threadsWantWork();
+
+/// Add the subtree below 'prefix' to this worker's deque, where other
+/// workers can steal it.
+void donateThreadWork(const std::vector<Controller::triple>& prefix);
+
+/// Ask all workers to stop (for example, at the solution limit).
+void stopThreadedSearch();
+bool threadedSearchStopped();
+
+/// Record a solution in the total over all workers. Returns false if
+/// enough solutions have already been found, in which case this solution
+/// should be ignored. Must be called with the solution output locked.
+bool claimThreadSolution();
 } // namespace Parallel
 
 #endif
\ No newline at end of file
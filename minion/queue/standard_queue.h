@@ -9,6 +9,8 @@
 #define queuePop pop_front
 
 #include "../get_info/get_info.h"
+#include "../get_info/prop_profile.h"
+#include "../search/learning_trail.h"
 #include "../solver.h"
 #include "../triggering/constraint_abstract.h"
 #include "../triggering/triggers.h"
@@ -27,12 +29,80 @@ class Queues {
 
   TriggerBacktrackQueue tbq;
 
+  // Set by -prop-profile. While profiling, every propagator call is timed,
+  // and credited with the values removed (counted by the variables'
+  // TriggerLists) while it ran.
+  bool profiling;
+  // Set when a search order uses constraint weights. Constraints which fail
+  // while weighting have their weights increased.
+  bool weighting;
+  // Set by -learning. The trail is told which constraint is propagating.
+  LearningTrail* learningTrail;
+  unsigned long long removedValues;
+  unsigned long long profileStartTicks;
+  std::chrono::steady_clock::time_point profileStartTime;
+
+  template <typename Propagate>
+  void profiledCall(AbstractConstraint* con, Propagate propagate) {
+    const unsigned long long removedBefore = removedValues;
+    const unsigned long long start = readProfileTicks();
+    propagate();
+    con->profile.ticks += readProfileTicks() - start;
+    con->profile.calls++;
+    con->profile.removed += removedValues - removedBefore;
+  }
+
 public:
   TriggerBacktrackQueue& getTbq() {
     return tbq;
   }
 
-  Queues() {}
+  Queues()
+      : profiling(false),
+        weighting(false),
+        learningTrail(nullptr),
+        removedValues(0),
+        profileStartTicks(0) {}
+
+  void startProfiling() {
+    profiling = true;
+    profileStartTicks = readProfileTicks();
+    profileStartTime = std::chrono::steady_clock::now();
+  }
+
+  bool isProfiling() const {
+    return profiling;
+  }
+
+  void startWeighting() {
+    weighting = true;
+  }
+
+  bool isWeighting() const {
+    return weighting;
+  }
+
+  void startLearning(LearningTrail* trail) {
+    learningTrail = trail;
+  }
+
+  LearningTrail* getLearningTrail() const {
+    return learningTrail;
+  }
+
+  void countRemovedValues(DomainInt count) {
+    // Bounds can appear to move backwards once the solver has failed.
+    if(count > 0)
+      removedValues += checked_cast<SysInt>(count);
+  }
+
+  /// The rate of readProfileTicks(), measured since profiling started.
+  double profileTicksPerSecond() const {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - profileStartTime;
+    if(elapsed.count() <= 0)
+      return 1;
+    return (readProfileTicks() - profileStartTicks) / elapsed.count();
+  }
 
   void pushSpecialTrigger(AbstractConstraint* trigger) {
     CON_INFO_ADDONE(AddSpecialToQueue);
@@ -64,7 +134,7 @@ public:
 
   // Subclass this class and change the following three methods.
 
-  template <bool is_root_node>
+  template <bool is_root_node, bool weighted, bool learning>
   bool propagateDynamicTriggerLists() {
     D_ASSERT(!getState().isFailed());
     bool* failPtr = getState().getFailedPtr();
@@ -79,13 +149,16 @@ public:
       while(pos < dtl.size()) {
         Trig_ConRef ref = dtl[pos];
         if(!ref.empty() && (!is_root_node || ref.con->fullPropagateDone)) {
-          ref.propagate(delta);
+          if(learning)
+            learningTrail->propagator = ref.con;
+          if(profiling)
+            profiledCall(ref.con, [&] { ref.propagate(delta); });
+          else
+            ref.propagate(delta);
         }
 
-#ifdef WDEG
-        if(*failPtr)
+        if(weighted && *failPtr)
           ref.constraint()->incWdeg();
-#endif
 
         if(*failPtr) {
           return true;
@@ -98,7 +171,7 @@ public:
     return false;
   }
 
-  template <bool is_root_node>
+  template <bool is_root_node, bool weighted, bool learning>
   inline void propagateQueueImpl() {
     D_ASSERT(!getState().isFailed());
 
@@ -106,7 +179,7 @@ public:
       D_ASSERT(!getState().isFailed());
 
       while(!dynamicTriggerList.empty()) {
-        if(propagateDynamicTriggerLists<is_root_node>())
+        if(propagateDynamicTriggerLists<is_root_node, weighted, learning>())
           return;
       }
 
@@ -119,11 +192,14 @@ public:
       specialTriggers.queuePop();
 
       CON_INFO_ADDONE(SpecialTrigger);
-      trig->specialCheck();
-#ifdef WDEG
-      if(getState().isFailed())
+      if(learning)
+        learningTrail->propagator = trig;
+      if(profiling)
+        profiledCall(trig, [&] { trig->specialCheck(); });
+      else
+        trig->specialCheck();
+      if(weighted && getState().isFailed())
         trig->incWdeg();
-#endif
 
       if(getState().isFailed()) {
         return;
@@ -132,12 +208,29 @@ public:
 
   } // end Function
 
+  // Weighting and learning are checked once per call, rather than for every
+  // propagator.
+  template <bool is_root_node>
+  inline void propagateQueueDispatch() {
+    if(learningTrail) {
+      if(weighting)
+        propagateQueueImpl<is_root_node, true, true>();
+      else
+        propagateQueueImpl<is_root_node, false, true>();
+    } else {
+      if(weighting)
+        propagateQueueImpl<is_root_node, true, false>();
+      else
+        propagateQueueImpl<is_root_node, false, false>();
+    }
+  }
+
   inline void propagateQueueRoot() {
-    return propagateQueueImpl<true>();
+    propagateQueueDispatch<true>();
   }
 
   inline void propagateQueue() {
-    return propagateQueueImpl<false>();
+    propagateQueueDispatch<false>();
   }
 };
 
@@ -0,0 +1,233 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+#ifndef LEARNINGSEARCHMANAGER_H
+#define LEARNINGSEARCHMANAGER_H
+
+#include "../constraints/constraint_nogood.h"
+#include "SearchManager.h"
+#include "learning_trail.h"
+
+namespace Controller {
+
+// Search for -learning. Each failure is explained by the assignments which
+// caused it, and resolved back to the first unique implication point (1-UIP)
+// to give a nogood. Search then backjumps to the deepest level where the
+// nogood propagates, and adds it to the problem.
+//
+// Every variable must be Boolean. A constraint can then always explain a
+// pruning by the assignments in its scope made before it, which
+// explainsWith() lets constraints narrow down.
+struct LearningSearchManager : public StandardSearchManager {
+  LearningTrail trail;
+
+  // The base Boolean variable of each variable in each constraint which has
+  // explained something, or -1 for constants.
+  MAP_TYPE<AbstractConstraint*, vector<SysInt>> scopes;
+
+  // The variables in the nogood being learnt.
+  vector<char> seen;
+
+  // The level search starts at. Assignments made by then always hold.
+  SysInt rootLevel;
+
+  LearningSearchManager(
+      shared_ptr<VariableOrder> _varOrder, shared_ptr<Propagate> _prop,
+      std::function<void(const vector<AnyVarRef>&, const vector<Controller::triple>&)> _check_func,
+      std::function<void(void)> _handle_sol_func, std::function<void(void)> _handle_opt_func)
+      : StandardSearchManager(_varOrder, _prop, _check_func, _handle_sol_func, _handle_opt_func),
+        trail(getVars().boolVarContainer.varCount()),
+        seen(getVars().boolVarContainer.varCount()),
+        rootLevel(0) {
+    getState().getGenericBacktracker().add(&trail);
+    getVars().boolVarContainer.learningTrail = &trail;
+    getQueue().startLearning(&trail);
+  }
+
+  virtual ~LearningSearchManager() {
+    getQueue().startLearning(nullptr);
+    getVars().boolVarContainer.learningTrail = nullptr;
+    getState().getGenericBacktracker().remove(&trail);
+  }
+
+  const vector<SysInt>& getScope(AbstractConstraint* con) {
+    auto it = scopes.find(con);
+    if(it != scopes.end())
+      return it->second;
+    vector<SysInt>& scope = scopes[con];
+    for(const AnyVarRef& v : *con->getVarsSingleton()) {
+      Var base = v.getBaseVar();
+      scope.push_back(base.type() == VAR_BOOL ? base.pos() : -1);
+    }
+    return scope;
+  }
+
+  // Adds the assignments which explain what 'con' did when the trail had
+  // 'before' entries to the nogood, counting those made at the current level
+  // in 'current' and storing the others in 'learnt'. Assignments made at the
+  // root are left out.
+  void explain(AbstractConstraint* con, SysInt before, SysInt& current, vector<SysInt>& learnt) {
+    const vector<SysInt>& scope = getScope(con);
+    vector<AnyVarRef>& vars = *con->getVarsSingleton();
+    const SysInt level = trail.currentLevel();
+    for(SysInt i = 0; i < (SysInt)scope.size(); ++i) {
+      SysInt b = scope[i];
+      if(b == -1 || seen[b] || !vars[i].isAssigned() || trail.position[b] >= before ||
+         trail.level[b] <= rootLevel)
+        continue;
+      if(!con->explainsWith(i, vars[i].assignedValue()))
+        continue;
+      seen[b] = true;
+      if(trail.level[b] == level)
+        current++;
+      else
+        learnt.push_back(b);
+    }
+  }
+
+  // Returns the base variables of the 1-UIP nogood explaining the failure of
+  // 'failed'. The first is the implication point, and the second (if any) is
+  // the one assigned at the highest level.
+  vector<SysInt> analyse(AbstractConstraint* failed) {
+    vector<SysInt> learnt(1);
+    SysInt current = 0;
+    explain(failed, trail.trail.size(), current, learnt);
+
+    // A propagator can notice a failure late. The decision at this level is
+    // then added, which keeps the nogood correct.
+    if(current == 0) {
+      seen[trail.trail[trail.levelStart.back()]] = true;
+      current = 1;
+    }
+
+    SysInt index = trail.trail.size();
+    while(true) {
+      do {
+        --index;
+      } while(!seen[trail.trail[index]]);
+      SysInt var = trail.trail[index];
+      seen[var] = false;
+      if(--current == 0) {
+        learnt[0] = var;
+        break;
+      }
+      D_ASSERT(trail.reason[var]);
+      explain(trail.reason[var], trail.position[var], current, learnt);
+    }
+
+    SysInt highest = 1;
+    for(SysInt i = 1; i < (SysInt)learnt.size(); ++i) {
+      seen[learnt[i]] = false;
+      if(trail.level[learnt[i]] > trail.level[learnt[highest]])
+        highest = i;
+    }
+    if(learnt.size() > 1)
+      std::swap(learnt[1], learnt[highest]);
+    return learnt;
+  }
+
+  // Backjumps to the highest level where 'learnt' propagates, and adds it as
+  // a nogood. Returns false if the nogood fails at the root.
+  bool backjumpAndAdd(const vector<SysInt>& learnt) {
+    vector<AnyVarRef> vars;
+    vector<DomainInt> vals;
+    for(SysInt b : learnt) {
+      vars.push_back(getVars().boolVarContainer.getVarNum(b));
+      vals.push_back(vars.back().assignedValue());
+    }
+
+    SysInt target = (learnt.size() > 1) ? trail.level[learnt[1]] : rootLevel;
+    while(trail.currentLevel() > target) {
+      worldPop();
+      branches.pop_back();
+    }
+
+    AbstractConstraint* nogood = new NogoodConstraint(vars, vals);
+    trail.propagator = nogood;
+    getState().addConstraint(nogood);
+    return !(getState().isFailed() && branches.empty());
+  }
+
+  // Learns from the current failure. Returns false if there is nothing left
+  // to search.
+  bool learnFromFailure() {
+    getState().incrementBacktrackCount();
+    if(branches.empty())
+      return false;
+    maybe_print_backtrack();
+    return backjumpAndAdd(analyse(trail.propagator));
+  }
+
+  // Rules out the current solution by the decisions which reached it.
+  bool blockSolution() {
+    if(branches.empty())
+      return false;
+    vector<SysInt> decisions;
+    for(SysInt i = (SysInt)branches.size() - 1; i >= 0; --i)
+      decisions.push_back(varArray[branches[i].var].getBaseVar().pos());
+    return backjumpAndAdd(decisions);
+  }
+
+  virtual void search() {
+    rootLevel = trail.currentLevel();
+    maybe_print_node();
+    while(true) {
+      D_ASSERT(getQueue().isQueuesEmpty());
+
+      getState().incrementNodeCount();
+
+      check_func(varArray, branches);
+
+      pair<SysInt, DomainInt> varval = varOrder->pickVarVal();
+
+      if(varval.first == -1) {
+        {
+          Parallel::SolsoutLock lock;
+          check_sol_is_correct();
+          maybe_print_node(true);
+          handle_sol_func();
+        }
+        if(!blockSolution())
+          return;
+      } else {
+        maybe_print_node();
+        trail.propagator = nullptr;
+        branch_left(varval);
+        prop->prop(varArray);
+      }
+
+      while(getState().isFailed()) {
+        if(!learnFromFailure())
+          return;
+      }
+    }
+  }
+};
+
+shared_ptr<SearchManager> make_learning_search_manager(PropagationLevel propMethod,
+                                                       vector<SearchOrder> order) {
+  auto checkBoolean = [](const vector<AnyVarRef>& vars) {
+    for(const AnyVarRef& v : vars) {
+      VariableType type = v.getBaseVar().type();
+      if(type != VAR_BOOL && type != VAR_CONSTANT)
+        D_FATAL_ERROR("-learning can only be used when every variable is Boolean");
+    }
+  };
+
+  const vector<AbstractConstraint*>& constraints = getState().getConstraintList();
+  for(AbstractConstraint* c : constraints)
+    checkBoolean(*c->getVarsSingleton());
+
+  shared_ptr<VariableOrder> vo = makeSearchOrder_multiple(order);
+  checkBoolean(vo->getVars());
+  if(vo->hasAuxVars())
+    D_FATAL_ERROR("-learning is not compatible with VARORDER AUX");
+
+  return shared_ptr<SearchManager>(new LearningSearchManager(
+      vo, make_propagator(propMethod), standardTime_ctrlc_checks, standard_dealWith_solution,
+      []() {}));
+}
+
+} // namespace Controller
+
+#endif
@@ -44,6 +44,10 @@ struct StandardSearchManager : public SearchManager {
 
   vector<Controller::triple> branches; // L & R branches so far (isLeftBranch?,var,value)
 
+  // In threaded search, the branches taken (possibly by another thread) to
+  // reach the subtree currently being searched.
+  vector<Controller::triple> subtreeRoot;
+
   StandardSearchManager(
       shared_ptr<VariableOrder> _varOrder, shared_ptr<Propagate> _prop,
       std::function<void(const vector<AnyVarRef>&, const vector<Controller::triple>&)> _check_func,
@@ -72,6 +76,18 @@ struct StandardSearchManager : public SearchManager {
     branches.push_back(Controller::triple(true, picked.first, picked.second));
   }
 
+  inline void removeBranchValue(SysInt var, DomainInt val) {
+    // special case the upper and lower bounds to make it work for bound
+    // variables
+    if(varArray[var].min() == val) {
+      varArray[var].setMin(val + 1);
+    } else if(varArray[var].max() == val) {
+      varArray[var].setMax(val - 1);
+    } else {
+      varArray[var].removeFromDomain(val);
+    }
+  }
+
   inline bool branch_right() {
     while(!branches.empty() && !branches.back().isLeft) { // pop off all the
                                                           // RBs
@@ -98,15 +114,7 @@ struct StandardSearchManager : public SearchManager {
 
     D_ASSERT(varArray[var].inDomain(val));
 
-    // special case the upper and lower bounds to make it work for bound
-    // variables
-    if(varArray[var].min() == val) {
-      varArray[var].setMin(val + 1);
-    } else if(varArray[var].max() == val) {
-      varArray[var].setMax(val - 1);
-    } else {
-      varArray[var].removeFromDomain(val);
-    }
+    removeBranchValue(var, val);
     maybe_print_search_assignment(varArray[var], val, false);
     branches.push_back(Controller::triple(false, var, val));
 
@@ -144,6 +152,72 @@ struct StandardSearchManager : public SearchManager {
     return -1;
   }
 
+  // Split off some of the remaining search for idle threads to steal, in the
+  // same way as the fork based parallel search below splits the search.
+  void donate_work() {
+    vector<Controller::triple> prefix = subtreeRoot;
+    if(getOptions().parallelStealHigh) {
+      // Give away the right branch of the topmost left branch.
+      if(branches.empty())
+        return;
+      int steal = steal_work();
+      if(steal == -1)
+        return;
+      prefix.insert(prefix.end(), branches.begin(), branches.begin() + steal);
+      prefix.push_back(Controller::triple(false, branches[steal].var, branches[steal].val));
+      branches[steal].stolen = true;
+      Parallel::donateThreadWork(prefix);
+    } else {
+      // Give away the current left branch.
+      prefix.insert(prefix.end(), branches.begin(), branches.end());
+      Parallel::donateThreadWork(prefix);
+      getState().setFailed();
+    }
+  }
+
+  // Search the subtree reached by making the branching decisions in 'prefix'.
+  // Used by threaded search, where 'prefix' may come from a different thread.
+  void search_subtree(const vector<Controller::triple>& prefix) {
+    SysInt depth = Controller::getWorldDepth();
+    worldPush();
+    reset();
+    subtreeRoot = prefix;
+    for(const auto& t : prefix) {
+      if(getState().isFailed())
+        break;
+      if(t.isLeft)
+        varArray[t.var].assign(t.val);
+      else
+        removeBranchValue(t.var, t.val);
+    }
+    handle_opt_func();
+    if(!getState().isFailed()) {
+      prop->prop(varArray);
+    }
+    if(!getState().isFailed()) {
+      check_shared_bound();
+    }
+    if(!getState().isFailed()) {
+      search();
+    }
+    Controller::worldPopToDepth(depth);
+  }
+
+  // When searching in parallel, tighten the bound on the optimisation
+  // variables as soon as another process or thread finds a better solution.
+  void check_shared_bound() {
+    if(getState().isOptimisationProblem() && Parallel::boundChanged()) {
+      vector<DomainInt> bound = Parallel::getBound();
+      if(bound > getState().getOptimiseValues()) {
+        getState().setOptimiseValue(bound);
+        handle_opt_func();
+        if(!getState().isFailed()) {
+          prop->prop(varArray);
+        }
+      }
+    }
+  }
+
   // Most basic search procedure
   virtual void search() {
     maybe_print_node();
@@ -158,9 +232,17 @@ struct StandardSearchManager : public SearchManager {
 
       if(varval.first == -1) {
         // We have found a solution!
-        check_sol_is_correct();
-        maybe_print_node(true);
-        handle_sol_func();
+        {
+          // When searching in parallel, deal with each solution in one go,
+          // and only if it is better than any found elsewhere.
+          Parallel::SolsoutLock lock;
+          check_shared_bound();
+          if(!getState().isFailed()) {
+            check_sol_is_correct();
+            maybe_print_node(true);
+            handle_sol_func();
+          }
+        }
         if(varOrder->hasAuxVars()) { // There are AUX vars at the end of the var ordering.
           // Backtrack out of them.
           jump_out_aux_vars();
@@ -172,6 +254,13 @@ struct StandardSearchManager : public SearchManager {
         maybe_print_node();
         branch_left(varval);
         prop->prop(varArray);
+        if(!getState().isFailed()) {
+          check_shared_bound();
+        }
+      }
+
+      if(Parallel::threadsWantWork() && !getState().isFailed() && !in_aux_vars()) {
+        donate_work();
       }
 
       if(getOptions().parallel && !getState().isFailed() && !in_aux_vars()) {
@@ -249,6 +338,9 @@ struct StandardSearchManager : public SearchManager {
         if(!getState().isFailed()) {
           prop->prop(varArray);
         }
+        if(!getState().isFailed()) {
+          check_shared_bound();
+        }
       }
     }
   }
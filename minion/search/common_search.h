@@ -9,10 +9,6 @@
 #include "../variables/AnyVarRef.h"
 #include "../variables/mappings/variable_neg.h"
 
-#ifdef LIBMINION
-extern Globals* globals;
-#endif 
-
 namespace Controller {
 
 /// Sets optimisation variable.
@@ -103,27 +99,30 @@ void print_solution(Stream& sout, const PrintMatrix& print_matrix) {
 /// All operations to be performed when a solution is found.
 /// This function checks the solution is correct, and prints it if required.
 inline void check_sol_is_correct() {
+  Parallel::lockSolsout();
+
+  // In threaded search, other threads may already have found enough solutions.
+  if(!Parallel::claimThreadSolution()) {
+    Parallel::unlockSolsout();
+    throw EndOfSearch();
+  }
 
   getState().incrementSolutionCount();
 
   if(getOptions().solsoutWrite) {
-    Parallel::lockSolsout();
-
     vector<vector<AnyVarRef>> print_matrix = getState().getPrintMatrix();
     if(getOptions().solsoutJson) {
-      json_dump(print_matrix, GET_GLOBAL(solsoutfile));
+      json_dump(print_matrix, *GET_GLOBAL(solsoutfile));
     } else {
       for(UnsignedSysInt i = 0; i < print_matrix.size(); ++i)
         for(UnsignedSysInt j = 0; j < print_matrix[i].size(); ++j) {
           if(!print_matrix[i][j].isAssigned())
             INPUT_ERROR("Some variable was unassigned while writing solution to file.");
-          GET_GLOBAL(solsoutfile) << print_matrix[i][j].assignedValue() << " ";
+          *GET_GLOBAL(solsoutfile) << print_matrix[i][j].assignedValue() << " ";
         }
     }
-    GET_GLOBAL(solsoutfile) << "\n";
-    GET_GLOBAL(solsoutfile).flush();
-
-    Parallel::unlockSolsout();
+    *GET_GLOBAL(solsoutfile) << "\n";
+    GET_GLOBAL(solsoutfile)->flush();
   }
 
   if(getOptions().print_solution) {
@@ -135,6 +134,8 @@ inline void check_sol_is_correct() {
       print_solution(cout, getState().getPrintMatrix());
   }
 
+  Parallel::unlockSolsout();
+
   if(!getOptions().nocheck) {
     for(UnsignedSysInt i = 0; i < getState().getConstraintList().size(); i++)
       check_constraint(getState().getConstraintList()[i]);
@@ -290,6 +291,10 @@ inline void standardTime_ctrlc_checks(const vector<AnyVarRef>& varArray,
     throw EndOfSearch();
   }
 
+  if(Parallel::threadedSearchStopped()) {
+    throw EndOfSearch();
+  }
+
   if(Parallel::isAlarmActivated()) { // Either a timeout has occurred, or
                                      // ctrl+c has been pressed.
     generateRestartFile(varArray, branches);
@@ -330,10 +335,12 @@ void inline standard_dealWith_solution() {
         oss << "\n";
       }
     } else {
+      Parallel::lockSolsout();
       cout << "Solution found with Value: ";
       output_mapped_container(
           cout, rawOptVals, [](DomainInt v) { return v; }, true);
       cout << endl;
+      Parallel::unlockSolsout();
     }
 
     std::vector<DomainInt> optVals;
@@ -345,6 +352,7 @@ void inline standard_dealWith_solution() {
       optVals.back()++;
     }
     getState().setOptimiseValue(optVals);
+    Parallel::publishBound(optVals);
   }
 
   #ifdef LIBMINION
@@ -355,7 +363,7 @@ void inline standard_dealWith_solution() {
   }
   #endif
   // Note that sollimit = -1 if all solutions should be found.
-  if(getState().getSolutionCount() == getOptions().sollimit)
+  if(getState().getSolutionCount() == getOptions().sollimit || Parallel::threadedSearchStopped())
     throw EndOfSearch();
 }
 
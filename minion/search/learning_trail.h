@@ -0,0 +1,54 @@
+// Minion https://github.com/minion/minion
+// SPDX-License-Identifier: MPL-2.0
+
+#ifndef LEARNING_TRAIL_H
+#define LEARNING_TRAIL_H
+
+#include "../solver.h"
+#include "../system/system.h"
+
+class AbstractConstraint;
+
+// Used by -learning. Records every assignment to a Boolean variable, in
+// order, with the decision level it was made at and the constraint which
+// made it. Each world push starts a new decision level.
+struct LearningTrail : public Backtrackable {
+  // The constraint currently propagating, which is the reason for any
+  // assignment made now. Null while the search makes a decision.
+  AbstractConstraint* propagator;
+
+  // The assigned variables, in order.
+  vector<SysInt> trail;
+  // The size of 'trail' when each level started.
+  vector<SysInt> levelStart;
+
+  // For each assigned variable, its level, position in 'trail' and reason.
+  vector<SysInt> level;
+  vector<SysInt> position;
+  vector<AbstractConstraint*> reason;
+
+  LearningTrail(SysInt varCount)
+      : propagator(nullptr), level(varCount), position(varCount), reason(varCount) {}
+
+  void assigned(SysInt var) {
+    level[var] = levelStart.size();
+    position[var] = trail.size();
+    reason[var] = propagator;
+    trail.push_back(var);
+  }
+
+  SysInt currentLevel() const {
+    return levelStart.size();
+  }
+
+  virtual void mark() {
+    levelStart.push_back(trail.size());
+  }
+
+  virtual void pop() {
+    trail.resize(levelStart.back());
+    levelStart.pop_back();
+  }
+};
+
+#endif
@@ -2,13 +2,93 @@
 
 #include "SearchManager.h"
 
+#include "../constraints/constraint_nogood.h"
+
 namespace Controller {
+
+// The backtrack limits of successive restarts.
+struct RestartLimits {
+  RestartSchedule schedule;
+  double multiplier;
+  unsigned long long scale;
+  unsigned long long restarts;
+  unsigned long long limit;
+  unsigned long long outer;
+
+  RestartLimits(const SearchOptions::RestartStruct& options)
+      : schedule(options.schedule), multiplier(options.multiplier), restarts(0) {
+    scale = options.scale;
+    if(scale == 0)
+      scale = (schedule == RESTART_GEOMETRIC) ? 10 : 100;
+    limit = scale;
+    outer = scale;
+  }
+
+  // The i'th term (from 1) of 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+  static unsigned long long luby(unsigned long long i) {
+    while(true) {
+      unsigned long long k = 1;
+      while((1ULL << k) - 1 < i)
+        k++;
+      if(i == (1ULL << k) - 1)
+        return 1ULL << (k - 1);
+      i -= (1ULL << (k - 1)) - 1;
+    }
+  }
+
+  unsigned long long grow(unsigned long long l) {
+    if(l * multiplier > (1LL << 60))
+      return 1LL << 60;
+    return l * multiplier;
+  }
+
+  unsigned long long next() {
+    restarts++;
+    switch(schedule) {
+    case RESTART_GEOMETRIC: limit = grow(limit); return limit;
+    case RESTART_LUBY: return scale * luby(restarts);
+    case RESTART_INNER_OUTER: {
+      unsigned long long inner = limit;
+      limit = grow(limit);
+      if(limit > outer) {
+        outer = grow(outer);
+        limit = scale;
+      }
+      return inner;
+    }
+    }
+    abort();
+  }
+};
 struct RestartNewSearchManager : public Controller::SearchManager {
   PropagationLevel propMethod;
   vector<SearchOrder> initialOrder;
 
-  void doASearch(const vector<SearchOrder>& order, int backtracklimit) {
+  // The reduced nld-nogoods of the search which reached 'branches' (see
+  // Recording and Minimizing Nogoods from Restarts by Lecoutre et al). Each
+  // right branch var != val was only taken once every solution with the
+  // earlier left branches and var = val had been ruled out, so those left
+  // branches and var = val can't all hold.
+  vector<AbstractConstraint*> makeNogoods(const vector<AnyVarRef>& varArray,
+                                          const vector<Controller::triple>& branches) {
+    vector<AbstractConstraint*> nogoods;
+    vector<AnyVarRef> vars;
+    vector<DomainInt> vals;
+    for(const Controller::triple& t : branches) {
+      vars.push_back(varArray[t.var]);
+      vals.push_back(t.val);
+      if(!t.isLeft) {
+        nogoods.push_back(new NogoodConstraint(vars, vals));
+        vars.pop_back();
+        vals.pop_back();
+      }
+    }
+    return nogoods;
+  }
+
+  void doASearch(const vector<SearchOrder>& order, unsigned long long backtracklimit) {
     bool timeout = false;
+    bool limitReached = false;
 
     int depth = Controller::getWorldDepth();
     Controller::worldPush();
@@ -18,7 +98,7 @@ struct RestartNewSearchManager : public Controller::SearchManager {
 
     std::shared_ptr<Controller::StandardSearchManager> sm;
 
-    int initial_backtracks = getState().getBacktrackCount();
+    long long initial_backtracks = getState().getBacktrackCount();
 
     // std::cout << "Starting search\n";
 
@@ -31,8 +111,11 @@ struct RestartNewSearchManager : public Controller::SearchManager {
         throw EndOfSearch();
       }
 
-      if(getState().getBacktrackCount() - initial_backtracks > backtracklimit)
+      if((unsigned long long)(getState().getBacktrackCount() - initial_backtracks) >
+         backtracklimit) {
+        limitReached = true;
         throw EndOfSearch();
+      }
     };
 
     bool solutionFound = false;
@@ -59,13 +142,29 @@ struct RestartNewSearchManager : public Controller::SearchManager {
       throw EndOfSearch();
     } else if(timeout) {
       if(getOptions().timeoutActive && get_cpuTime() > getOptions().time_limit)
-        cout << "Time limit is reached, stop the search" << endl;
-      else
-        cout << "Node limit is reached, stop the search" << endl;
+        getOptions().printLine("Time limit is reached, stop the search");
+      else if(!Parallel::threadedSearchStopped())
+        getOptions().printLine("Node limit is reached, stop the search");
+      throw EndOfSearch();
+    } else if(!limitReached) {
+      // The search finished inside the limit, so there are no solutions.
       throw EndOfSearch();
     }
 
+    vector<AbstractConstraint*> nogoods;
+    if(getOptions().restart.nogoods)
+      nogoods = makeNogoods(sm->varArray, sm->branches);
+
     Controller::worldPopToDepth(depth);
+
+    // If the nogoods fail at the root, the whole search space has been ruled
+    // out.
+    for(AbstractConstraint* c : nogoods) {
+      if(!getState().addConstraint(c)) {
+        getOptions().printLine("Nogoods rule out every solution, stop the search");
+        throw EndOfSearch();
+      }
+    }
   }
 
   RestartNewSearchManager(PropagationLevel _propMethod, const vector<SearchOrder>& _order)
@@ -83,15 +182,15 @@ struct RestartNewSearchManager : public Controller::SearchManager {
 
   virtual void search() {
     bool useBias = getOptions().restart.bias;
-    double multiplier = getOptions().restart.multiplier;
 
-    unsigned long long i = 10;
+    RestartLimits limits(getOptions().restart);
+    bool firstSearch = true;
     while(true) {
-      i *= multiplier;
-      if(i > (1LL << 60)) {
-        i = 1LL << 60;
-      }
-      cout << "Increasing backtrack limit to " << i << endl;
+      if(!firstSearch)
+        getState().decayWeights();
+      firstSearch = false;
+      unsigned long long i = limits.next();
+      getOptions().printLine("Setting backtrack limit to " + tostring(i));
       int bias = 0;
       if(useBias)
         bias = rand() % 200 - 100;
@@ -32,15 +32,8 @@ shared_ptr<VariableOrder> makeSearchOrder(SearchOrder order) {
     vo = new ConflictBranch(varArray, order.valOrder, vo2);
     break;
 
-#ifdef WDEG
   case ORDER_WDEG: vo = new WdegBranch(varArray, order.valOrder); break;
   case ORDER_DOMOVERWDEG: vo = new DomOverWdegBranch(varArray, order.valOrder); break;
-#else
-  case ORDER_WDEG:
-  case ORDER_DOMOVERWDEG:
-    USER_ERROR("This minion was not compiled with support for wdeg or "
-               "domoverwdeg orderings (add -WDEG to build options)");
-#endif
 
   default: cout << "Order not found in makeSearchOrder." << endl; abort();
   }
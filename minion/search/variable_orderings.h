@@ -224,67 +224,303 @@ struct SlowStaticBranch : public VariableOrder {
   }
 };
 
-#ifdef WDEG
-// see Boosting Systematic Search by Weighting Constraints by Boussemart et al
-struct WdegBranch : public VariableOrder {
-  vector<ValOrder> valOrder;
+// Records when each of a list of variables is assigned, for WdegQueue. It is
+// not added to the model, and never prunes anything.
+struct WdegAssignmentWatcher : public AbstractConstraint {
+  vector<AnyVarRef> vars;
+  vector<SysInt>* assigned;
+
+  WdegAssignmentWatcher(const vector<AnyVarRef>& _vars, vector<SysInt>* _assigned)
+      : vars(_vars), assigned(_assigned) {}
+
+  virtual ~WdegAssignmentWatcher() {
+    for(SysInt i = 0; i < (SysInt)vars.size(); ++i)
+      releaseTriggerInt(i);
+  }
 
-  WdegBranch(const vector<AnyVarRef>& _varOrder, const vector<ValOrder>& _valOrder)
-      : VariableOrder(_varOrder), valOrder(_valOrder) {}
+  virtual string constraintName() {
+    return "wdeg-watcher";
+  }
 
-  pair<SysInt, DomainInt> pickVarVal() {
-    SysInt best = varOrder.size(); // the variable with the best score so far (init to none)
-    SysInt best_score = -1;        //... and its score (all true scores are positive)
-    size_t varOrderSize = varOrder.size();
-    for(size_t i = 0; i < varOrderSize; i++) { // we will find the score for each var
-      // cout << "i=" << i << endl;
-      // cout << "best=" << best << endl;
-      // cout << "best_score=" << best_score << endl;
-      AnyVarRef v = varOrder[i];
-      if(v.isAssigned()) {
-        // cout << "assigned -- stop" << endl;
-        continue;
+  virtual SysInt dynamicTriggerCount() {
+    return vars.size();
+  }
+
+  virtual vector<AnyVarRef> getVars() {
+    return vars;
+  }
+
+  virtual BOOL checkAssignment(DomainInt* v, SysInt vSize) {
+    return true;
+  }
+
+  virtual void fullPropagate() {
+    for(SysInt i = 0; i < (SysInt)vars.size(); ++i)
+      moveTriggerInt(vars[i], i, Assigned);
+  }
+
+  virtual void propagateDynInt(SysInt trig, DomainDelta) {
+    assigned->push_back(trig);
+  }
+};
+
+// The unassigned variables of a weighted ordering, with the future weight of
+// each: its weight, less the weight of its constraints which have no other
+// unassigned variables. They are kept sorted by future weight, largest
+// first, with ties broken by position in the ordering.
+//
+// Rather than recount the unassigned variables of every constraint at every
+// node, each constraint keeps a count which is updated as variables are
+// assigned, and the counts and the sorted variables are put back from a trail
+// when search backtracks. Future weights change when the counts fall to one,
+// or the weights of constraints increase, and only the variables involved
+// are updated.
+//
+// Constraints added after the ordering is created add to the weight of their
+// variables, but are never deducted.
+struct WdegQueue : public VariableOrder, Backtrackable, WdegListener {
+  // Entries are (-future weight, position in the ordering).
+  set<pair<double, SysInt>> queue;
+  vector<double> futureWeight;
+  vector<char> inQueue;
+
+  // The constraints on the variables in the ordering, and how many of the
+  // variables of each are unassigned.
+  vector<AbstractConstraint*> cons;
+  MAP_TYPE<AbstractConstraint*, SysInt> consIndex;
+  vector<SysInt> consUnassigned;
+  // The constraints on each variable in the ordering (repeated if a variable
+  // occurs more than once), and the positions of the variables in each
+  // constraint which occur in the ordering.
+  vector<vector<SysInt>> varCons;
+  vector<vector<SysInt>> consPositions;
+
+  // The unassigned variables of each constraint, and for each of them the
+  // constraints it is in and its positions in the ordering.
+  vector<AnyVarRef> watched;
+  vector<vector<SysInt>> watchedCons;
+  vector<vector<SysInt>> watchedPositions;
+  std::unique_ptr<WdegAssignmentWatcher> watcher;
+
+  // Watched variables assigned since their counts were last updated.
+  vector<SysInt> newlyAssigned;
+
+  // Each entry is either a constraint whose count was reduced, or -1 - the
+  // position of a variable taken out of the queue. 'trailMarks' holds the
+  // size of the trail at each world push since this was created.
+  vector<SysInt> trail;
+  vector<SysInt> trailMarks;
+
+  vector<SysInt> touched;
+
+  WdegQueue(const vector<AnyVarRef>& _varOrder)
+      : VariableOrder(_varOrder),
+        futureWeight(_varOrder.size()),
+        inQueue(_varOrder.size()),
+        varCons(_varOrder.size()) {
+    map<Var, vector<SysInt>> positions;
+    for(SysInt i = 0; i < (SysInt)varOrder.size(); ++i) {
+      positions[varOrder[i].getBaseVar()].push_back(i);
+      for(AbstractConstraint* c : *varOrder[i].getConstraints()) {
+        auto it = consIndex.find(c);
+        if(it == consIndex.end()) {
+          it = consIndex.insert(make_pair(c, (SysInt)cons.size())).first;
+          cons.push_back(c);
+        }
+        varCons[i].push_back(it->second);
       }
-      SysInt base_wdeg = checked_cast<SysInt>(v.getBaseWdeg());
-      // cout << "basewdeg=" << base_wdeg << endl;
-      if(base_wdeg <= best_score) {
-        // cout << "too low before deductions" << endl;
-        continue; // stop if base score is too low before deductions
+    }
+
+    // Variables in the ordering are watched even if they are in no constraint,
+    // so they can be taken out of the queue.
+    map<Var, SysInt> watchedIndex;
+    for(SysInt i = 0; i < (SysInt)varOrder.size(); ++i) {
+      Var base = varOrder[i].getBaseVar();
+      if(!varOrder[i].isAssigned() && watchedIndex.count(base) == 0) {
+        watchedIndex[base] = watched.size();
+        watched.push_back(varOrder[i]);
+        watchedCons.push_back(vector<SysInt>());
+        watchedPositions.push_back(positions[base]);
       }
-      vector<AbstractConstraint*>* constrs = v.getConstraints();
-      size_t constrsSize = constrs->size();
-      for(size_t j = 0; j < constrsSize; j++) { // find constrs to be deducted from var wdeg
-        AbstractConstraint* c = (*constrs)[j];
-        // cout << "con wdeg=" << c->getWdeg() << endl;
-        vector<AnyVarRef>* c_vars = c->getVarsSingleton();
-        size_t c_varsSize = c_vars->size();
-        SysInt uninst = 0;
-        for(size_t k = 0; k < c_varsSize; k++)
-          if(!(*c_vars)[k].isAssigned())
-            if(++uninst > 1) { // when multiple unassigned we needn't deduct
-              // cout << "don't deduct" << endl;
-              break;
-            }
-        if(uninst <= 1) {
-          D_ASSERT(uninst == 1);
-          // cout << "deduct" << endl;
-          base_wdeg -= c->getWdeg();
-          if(base_wdeg <= best_score) {
-            // cout << "too low during deductions" << endl;
-            break;
-          }
+    }
+
+    consUnassigned.resize(cons.size());
+    consPositions.resize(cons.size());
+    for(SysInt k = 0; k < (SysInt)cons.size(); ++k) {
+      for(AnyVarRef& v : *cons[k]->getVarsSingleton()) {
+        Var base = v.getBaseVar();
+        auto pos = positions.find(base);
+        if(pos != positions.end()) {
+          consPositions[k].insert(consPositions[k].end(), pos->second.begin(), pos->second.end());
+        }
+        if(v.isAssigned())
+          continue;
+        consUnassigned[k]++;
+        auto it = watchedIndex.find(base);
+        if(it == watchedIndex.end()) {
+          it = watchedIndex.insert(make_pair(base, (SysInt)watched.size())).first;
+          watched.push_back(v);
+          watchedCons.push_back(vector<SysInt>());
+          watchedPositions.push_back(pos != positions.end() ? pos->second : vector<SysInt>());
         }
+        watchedCons[it->second].push_back(k);
       }
-      // cout << "basewdeg=" << base_wdeg << endl;
-      if(best_score < base_wdeg) {
-        // cout << "replacing top score" << endl;
-        best_score = base_wdeg;
-        best = i;
+    }
+
+    for(SysInt i = 0; i < (SysInt)varOrder.size(); ++i) {
+      if(!varOrder[i].isAssigned())
+        insert(i);
+    }
+
+    watcher.reset(new WdegAssignmentWatcher(watched, &newlyAssigned));
+    watcher->setup();
+    watcher->fullPropagate();
+    watcher->fullPropagateDone = true;
+
+    getState().getGenericBacktracker().add(this);
+    getState().addWdegListener(this);
+    getQueue().startWeighting();
+  }
+
+  virtual ~WdegQueue() {
+    getState().getGenericBacktracker().remove(this);
+    getState().removeWdegListener(this);
+  }
+
+  double calcFutureWeight(SysInt i) {
+    double weight = varOrder[i].getBaseWdeg();
+    for(SysInt k : varCons[i]) {
+      if(consUnassigned[k] <= 1)
+        weight -= cons[k]->getWdeg();
+    }
+    return weight;
+  }
+
+  void insert(SysInt i) {
+    D_ASSERT(!inQueue[i]);
+    futureWeight[i] = calcFutureWeight(i);
+    queue.insert(make_pair(-futureWeight[i], i));
+    inQueue[i] = true;
+  }
+
+  void erase(SysInt i) {
+    D_ASSERT(inQueue[i]);
+    queue.erase(make_pair(-futureWeight[i], i));
+    inQueue[i] = false;
+  }
+
+  void update(SysInt i) {
+    if(inQueue[i] && futureWeight[i] != calcFutureWeight(i)) {
+      erase(i);
+      insert(i);
+    }
+  }
+
+  // Brings the queue up to date with the variables assigned since it was
+  // last called.
+  void updateAssigned() {
+    if(newlyAssigned.empty())
+      return;
+    touched.clear();
+    for(SysInt w : newlyAssigned) {
+      for(SysInt i : watchedPositions[w]) {
+        if(inQueue[i]) {
+          erase(i);
+          trail.push_back(-1 - i);
+        }
+      }
+      for(SysInt k : watchedCons[w]) {
+        consUnassigned[k]--;
+        trail.push_back(k);
+        if(consUnassigned[k] == 1)
+          touched.push_back(k);
       }
     }
+    newlyAssigned.clear();
+    for(SysInt k : touched) {
+      for(SysInt i : consPositions[k])
+        update(i);
+    }
+  }
 
-    // new bit. pn
-    if(best == varOrder.size())
+  virtual void wdegChanged(AbstractConstraint* c) {
+    auto it = consIndex.find(c);
+    if(it != consIndex.end()) {
+      for(SysInt i : consPositions[it->second])
+        update(i);
+      return;
+    }
+    // A constraint added since this was created.
+    for(AnyVarRef& v : *c->getVarsSingleton()) {
+      for(SysInt i = 0; i < (SysInt)varOrder.size(); ++i) {
+        if(varOrder[i].getBaseVar() == v.getBaseVar())
+          update(i);
+      }
+    }
+  }
+
+  void mark() {
+    // Assignments made before the push belong to the level being left.
+    updateAssigned();
+    trailMarks.push_back(trail.size());
+  }
+
+  void pop() {
+    // Assignments not yet counted belong to the level being popped.
+    newlyAssigned.clear();
+    // Popping past the level this was created at puts everything back.
+    SysInt mark = 0;
+    if(!trailMarks.empty()) {
+      mark = trailMarks.back();
+      trailMarks.pop_back();
+    }
+    touched.clear();
+    vector<SysInt> restored;
+    while((SysInt)trail.size() > mark) {
+      SysInt entry = trail.back();
+      trail.pop_back();
+      if(entry >= 0) {
+        consUnassigned[entry]++;
+        touched.push_back(entry);
+      } else {
+        restored.push_back(-1 - entry);
+      }
+    }
+    for(SysInt k : touched) {
+      for(SysInt i : consPositions[k])
+        update(i);
+    }
+    for(SysInt i : restored)
+      insert(i);
+  }
+
+  // Returns the position of the unassigned variable with the largest future
+  // weight, or the first in the ordering of those with the largest, or -1 if
+  // all are assigned.
+  SysInt heaviest() {
+    updateAssigned();
+    while(!queue.empty()) {
+      SysInt i = queue.begin()->second;
+      if(!varOrder[i].isAssigned())
+        return i;
+      D_ASSERT(false);
+      erase(i);
+      trail.push_back(-1 - i);
+    }
+    return -1;
+  }
+};
+
+// see Boosting Systematic Search by Weighting Constraints by Boussemart et al
+struct WdegBranch : public WdegQueue {
+  vector<ValOrder> valOrder;
+
+  WdegBranch(const vector<AnyVarRef>& _varOrder, const vector<ValOrder>& _valOrder)
+      : WdegQueue(_varOrder), valOrder(_valOrder) {}
+
+  pair<SysInt, DomainInt> pickVarVal() {
+    SysInt best = heaviest();
+    if(best == -1)
       return make_pair(-1, 0);
 
     DomainInt val = chooseVal(varOrder[best], valOrder[best]);
@@ -292,27 +528,31 @@ struct WdegBranch : public VariableOrder {
   }
 };
 
-struct DomOverWdegBranch : VariableOrder {
+struct DomOverWdegBranch : WdegQueue {
   vector<ValOrder> valOrder;
+  // CHS weights start at zero, so a small weight is added to every variable
+  // to choose by domain size until there are conflicts.
+  double smoothing;
 
   DomOverWdegBranch(const vector<AnyVarRef>& _varOrder, const vector<ValOrder>& _valOrder)
-      : VariableOrder(_varOrder), valOrder(_valOrder) {}
+      : WdegQueue(_varOrder),
+        valOrder(_valOrder),
+        smoothing(getOptions().weighting == WEIGHTING_CHS ? 1e-4 : 0) {}
 
+  // Domain sizes change throughout search, so every unassigned variable is
+  // checked, but their future weights are already known.
   pair<SysInt, DomainInt> pickVarVal() {
-    // cout << "using domoverwdeg" << endl;
+    updateAssigned();
     SysInt best = varOrder.size(); // the variable with the best score so far (init to none)
     float best_score = FLT_MAX;    //... and its score (all true scores are positive)
     size_t varOrderSize = varOrder.size();
     bool anyUnassigned = false;
     for(size_t i = 0; i < varOrderSize; i++) { // we will find the score for each var
-      // cout << "i=" << i << endl;
-      // cout << "best=" << best << endl;
-      // cout << "best_score=" << best_score << endl;
-      AnyVarRef v = varOrder[i];
-      if(v.isAssigned()) {
-        // cout << "assigned -- stop" << endl;
+      if(!inQueue[i])
         continue;
-      } else if(!anyUnassigned) {
+      AnyVarRef& v = varOrder[i];
+      D_ASSERT(!v.isAssigned());
+      if(!anyUnassigned) {
         // always use the first unassigned as a fallback in case later
         // calculations don't find
         // any variables with finite score
@@ -320,56 +560,21 @@ struct DomOverWdegBranch : VariableOrder {
         anyUnassigned = true;
       }
       const SysInt domSize_approx = checked_cast<SysInt>(v.max() - v.min() + 1);
-      DomainInt base_wdeg = v.getBaseWdeg();
-      // cout << "basewdeg=" << base_wdeg << endl;
-      if((float)domSize_approx / checked_cast<SysInt>(base_wdeg) >= best_score) {
-        // cout << "too high before deductions" << endl;
-        continue; // stop if base score is too low before deductions
-      }
-      vector<AbstractConstraint*>* constrs = v.getConstraints();
-      size_t constrsSize = constrs->size();
-      for(size_t j = 0; j < constrsSize; j++) { // find constrs to be deducted from var wdeg
-        AbstractConstraint* c = (*constrs)[j];
-        // cout << "con wdeg=" << c->getWdeg() << endl;
-        vector<AnyVarRef>* c_vars = c->getVarsSingleton();
-        size_t c_varsSize = c_vars->size();
-        SysInt uninst = 0;
-        for(size_t k = 0; k < c_varsSize; k++)
-          if(!(*c_vars)[k].isAssigned())
-            if(++uninst > 1) { // when multiple unassigned we needn't deduct
-              // cout << "don't deduct" << endl;
-              break;
-            }
-        if(uninst <= 1) {
-          D_ASSERT(uninst == 1);
-          // cout << "deduct" << endl;
-          base_wdeg -= c->getWdeg();
-          if((float)domSize_approx / checked_cast<SysInt>(base_wdeg) >= best_score) {
-            // cout << "too high during deductions,base_wdeg=" << base_wdeg <<
-            // endl;
-            break;
-          }
-        }
-      }
-      // cout << "basewdeg=" << base_wdeg << endl;
-      if(best_score > (float)domSize_approx / checked_cast<SysInt>(base_wdeg)) {
-        // cout << "replacing top score" << endl;
-        best_score = (float)domSize_approx / checked_cast<SysInt>(base_wdeg);
+      float score = (float)domSize_approx / (float)(std::max(futureWeight[i], 0.0) + smoothing);
+      if(best_score > score) {
+        best_score = score;
         best = i;
       }
     }
-    // cout << "dec=" << best << "@" << best_score << endl;
-    D_ASSERT(!anyUnassigned || best != varOrderSize);
 
     // new bit. pn
-    if(best == varOrder.size())
+    if(best == (SysInt)varOrder.size())
       return make_pair(-1, 0);
 
     DomainInt val = chooseVal(varOrder[best], valOrder[best]);
     return make_pair(best, val);
   }
 };
-#endif
 
 struct SRFBranch : VariableOrder {
   vector<ValOrder> valOrder;
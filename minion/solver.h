@@ -24,6 +24,15 @@ namespace ProbSpec {
 struct CSPInstance;
 }
 
+/// Implemented by search orders which need to know when the weights of
+/// variables change.
+struct WdegListener {
+  /// Called when the weight of 'c' changes, or 'c' is added, so the
+  /// weights of its variables have changed.
+  virtual void wdegChanged(AbstractConstraint* c) = 0;
+  virtual ~WdegListener() {}
+};
+
 class SearchState {
 
   long long nodes;
@@ -56,6 +65,12 @@ class SearchState {
 
   GenericBacktracker generic_backtracker;
 
+  vector<WdegListener*> wdegListeners;
+
+  // Conflicts so far, and the step size, used by CHS weighting.
+  long long conflicts;
+  double chsAlpha;
+
 public:
   std::string storedSolution;
 
@@ -67,6 +82,25 @@ public:
     return generic_backtracker;
   }
 
+  const vector<WdegListener*>& getWdegListeners() {
+    return wdegListeners;
+  }
+
+  void addWdegListener(WdegListener* l) {
+    wdegListeners.push_back(l);
+  }
+
+  void removeWdegListener(WdegListener* l) {
+    wdegListeners.erase(std::remove(wdegListeners.begin(), wdegListeners.end(), l),
+                        wdegListeners.end());
+  }
+
+  /// The amount to add to the weight of 'c', which has just failed.
+  double conflictWeightIncrease(AbstractConstraint* c);
+
+  /// Decays the weights of all constraints, at a restart.
+  void decayWeights();
+
   ProbSpec::CSPInstance* getInstance() {
     return csp_instance;
   }
@@ -215,7 +249,9 @@ public:
         constraintsToPropagate(1),
         solutions(0),
         finished(false),
-        failed(false)
+        failed(false),
+        conflicts(0),
+        chsAlpha(0.1)
         {}
 
   // Must be defined later.
@@ -225,6 +261,27 @@ public:
 struct NhConfig;
 std::shared_ptr<NhConfig> makeNhConfig();
 
+/// How the backtrack limit grows between restarts.
+enum RestartSchedule {
+  /// Multiply the limit by a constant each restart.
+  RESTART_GEOMETRIC,
+  /// The Luby sequence 1, 1, 2, 1, 1, 2, 4, 1, ... times a constant.
+  RESTART_LUBY,
+  /// An inner limit grows geometrically until it reaches an outer limit,
+  /// which then grows, and the inner limit starts again.
+  RESTART_INNER_OUTER
+};
+
+/// How constraint weights, used by the wdeg and domoverwdeg orderings, are
+/// updated when a constraint fails.
+enum WeightingScheme {
+  /// Add one (Boussemart et al, 2004).
+  WEIGHTING_WDEG,
+  /// Conflict History Search: move towards a reward which is larger for
+  /// constraints which failed recently (Habet and Terrioux, 2021).
+  WEIGHTING_CHS
+};
+
 /// Stored all the options related to search. This item should not
 /// be changed during search.
 class SearchOptions {
@@ -232,12 +289,26 @@ class SearchOptions {
 public:
   struct RestartStruct {
     bool active = false;
+    RestartSchedule schedule = RESTART_GEOMETRIC;
     double multiplier = 1.5;
+    /// The first backtrack limit, or 0 to use the schedule's default.
+    unsigned long long scale = 0;
     bool bias = true;
+    /// Record nogoods from the search abandoned at each restart.
+    bool nogoods = true;
   };
 
   RestartStruct restart;
 
+  /// How constraint weights are updated. Weights are only kept when a search
+  /// order needs them.
+  WeightingScheme weighting = WEIGHTING_WDEG;
+  /// All constraint weights are multiplied by this at each restart.
+  double weightDecay = 1;
+
+  /// Learn a nogood from each failure, and backjump (-learning).
+  bool learning = false;
+
   /// Denotes if minion should print no output, other than that explicitally
   /// requested
   bool silent;
@@ -291,6 +362,8 @@ public:
   string instance_name;
 
   bool redump;
+  /// If not empty, write the parsed instance to this file in binary form.
+  string binaryOut;
   bool graph;
   bool instance_stats;
 
@@ -318,6 +391,17 @@ public:
   int parallelcores = 0;
   bool parallelStealHigh = true;
 
+  // Number of threads used by threaded search (0 means a normal, single
+  // threaded search).
+  int threads = 0;
+
+  // In threaded search, should each thread search the whole problem using a
+  // different strategy, rather than sharing the search?
+  bool portfolio = false;
+
+  // Time, and count the removals of, each constraint's propagation.
+  bool propProfile = false;
+
   // Gather AMOs
   bool gatherAMOs = false;
   bool gatherAMOsExtra = false;
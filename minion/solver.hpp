@@ -69,6 +69,8 @@ inline bool SearchState::addConstraint(AbstractConstraint* c) {
   size_t vars_s = vars->size();
   for(size_t i = 0; i < vars_s; i++) // note all constraints the var is involved in
     (*vars)[i].addConstraint(c);
+  for(WdegListener* l : wdegListeners)
+    l->wdegChanged(c);
 
   c->setup();
   c->fullPropagate();
@@ -90,3 +92,35 @@ inline void SearchState::redoFullPropagate(AbstractConstraint* c) {
   constraintsToPropagate[Controller::getWorldDepth()].insert(c);
   c->fullPropagate();
 }
+
+inline double SearchState::conflictWeightIncrease(AbstractConstraint* c) {
+  if(getOptions().weighting == WEIGHTING_WDEG)
+    return 1;
+
+  // The reward is 1 if 'c' caused the previous conflict, and smaller the
+  // longer ago it last caused one.
+  double reward = 1.0 / (conflicts - c->lastConflict + 1);
+  double increase = chsAlpha * (reward - c->getWdeg());
+  c->lastConflict = conflicts;
+  conflicts++;
+  chsAlpha = std::max(0.06, chsAlpha - 1e-6);
+  return increase;
+}
+
+inline void SearchState::decayWeights() {
+  if(!getQueue().isWeighting())
+    return;
+  for(AbstractConstraint* c : constraints) {
+    double wdeg = c->getWdeg() * getOptions().weightDecay;
+    // CHS also forgets constraints which haven't failed for a while.
+    if(getOptions().weighting == WEIGHTING_CHS)
+      wdeg *= std::pow(0.995, (double)(conflicts - c->lastConflict));
+    if(wdeg != c->getWdeg()) {
+      c->addWdeg(wdeg - c->getWdeg());
+      for(WdegListener* l : wdegListeners)
+        l->wdegChanged(c);
+    }
+  }
+  if(getOptions().weighting == WEIGHTING_CHS)
+    chsAlpha = 0.1;
+}
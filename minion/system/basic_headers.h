@@ -44,6 +44,7 @@
 #endif // _MSC_VER
 
 #include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -77,40 +78,13 @@
 using namespace std;
 
 /*
- * When using as a library, store globals on heap.
- * This allows them to be easily reinitialised for multiple runs.
- *
- * This globals struct is initialised in globals.cpp.
- *
- * For simplicity, it contains set fields that should be hardcoded in.
+ * All of Minion's global state is stored on the heap, in a 'Globals' object
+ * (see globals.h). Each thread has its own current Globals, which allows them
+ * to be easily reinitialised for multiple library runs, and allows threaded
+ * search to give each worker thread its own copy of the solver state.
  */
 
-#ifndef IN_MAIN
-
-#ifdef LIBMINION
-#define VARDEF_ASSIGN(x, y) extern Globals* globals
-#define VARDEF(x) extern Globals* globals
-#else
-#define VARDEF_ASSIGN(x, y) extern x
-#define VARDEF(x) extern x
-#endif
-
-#else /* IN MAIN */
-
-#ifdef LIBMINION
-#define VARDEF_ASSIGN(x, y)
-#define VARDEF(x)
-#else 
-#define VARDEF_ASSIGN(x, y) x(y)
-#define VARDEF(x) x
-#endif
-#endif
-
 #define BOOL bool
 
-#ifdef LIBMINION
 #define GET_GLOBAL(x) (::globals->x)
-#else
-#define GET_GLOBAL(x) x
-#endif
 #endif
@@ -1,4 +1,7 @@
 #ifndef _GLOBALS_FORWARD_H
 #define _GLOBALS_FORWARD_H
 struct Globals;
+
+// The solver state used by the current thread (defined in globals.cpp).
+extern thread_local Globals* globals;
 #endif
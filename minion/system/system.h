@@ -68,6 +68,4 @@ inline void* checked_realloc(void* ptr, size_t size) {
 
 #include <random>
 
-VARDEF(std::mt19937 global_random_gen);
-
 #endif
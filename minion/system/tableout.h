@@ -131,11 +131,9 @@ public:
   }
 };
 
-// Provide a global singleton of the above class. Not threadsafe!
-inline TableOut& getTableOut() {
-  static TableOut t;
-  return t;
-}
+// Each Globals owns one TableOut, so every solver (and every search thread)
+// records its own results. Defined in globals.cpp.
+TableOut& getTableOut();
 
 // Design assumption: Column headings will always be sorted in alphabetical
 // order. ??
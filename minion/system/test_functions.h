@@ -95,15 +95,8 @@ string getDom_as_string(const vector<T>& vec) {
 template <typename Vars>
 DomainInt litCount(Vars& v) {
   DomainInt lits = 0;
-  for(SysInt i = 0; i < (SysInt)v.size(); ++i) {
-    if(v[i].isBound()) {
-      lits += v[i].max() - v[i].min() + 1;
-    } else {
-      for(DomainInt j = v[i].min(); j <= v[i].max(); ++j)
-        if(v[i].inDomain(j))
-          lits++;
-    }
-  }
+  for(SysInt i = 0; i < (SysInt)v.size(); ++i)
+    lits += v[i].domSize();
   return lits;
 }
 
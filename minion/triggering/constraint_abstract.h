@@ -12,6 +12,7 @@
 
 #include "../variables/AnyVarRef.h"
 #include "../globals.h"
+#include "../get_info/prop_profile.h"
 
 #include <vector>
 
@@ -86,9 +87,14 @@ public:
     _restoreTriggerOnBacktrack(tcr);
   }
 
-#ifdef WDEG
-  UnsignedSysInt wdeg;
-#endif
+  /// The weight of this constraint, for the wdeg and domoverwdeg
+  /// orderings. Only updated while the queue is weighting constraints.
+  double wdeg;
+  /// The conflict count when this constraint last failed, for CHS.
+  long long lastConflict;
+
+  /// Only updated when running with -prop-profile.
+  PropProfileCounters profile;
 
   BOOL fullPropagateDone;
 
@@ -143,9 +149,8 @@ public:
       : parent((AbstractConstraint*)BAD_POINTER),
         childpos(-1),
         singleton_vars(),
-#ifdef WDEG
-        wdeg(1),
-#endif
+        wdeg(getOptions().weighting == WEIGHTING_CHS ? 0 : 1),
+        lastConflict(0),
         fullPropagateDone(false) {
   }
 
@@ -165,6 +170,14 @@ public:
   // Returns the variables of the constraint
   virtual vector<AnyVarRef> getVars() = 0;
 
+  /// Used by -learning, where every variable is Boolean. Returns false if
+  /// getVars()[var] taking the value 'val' can never make this constraint
+  /// prune or fail, so it can be left out of the explanations of this
+  /// constraint's prunings.
+  virtual bool explainsWith(SysInt var, DomainInt val) {
+    return true;
+  }
+
   vector<AnyVarRef>* getVarsSingleton() // piggyback singleton vector on getVars()
   {
     if(singleton_vars.size() == 0)
@@ -172,19 +185,26 @@ public:
     return &singleton_vars;
   }
 
-#ifdef WDEG
-  inline UnsignedSysInt getWdeg() {
+  inline double getWdeg() {
     return wdeg;
   }
 
-  inline void incWdeg() {
-    wdeg += 1;
+  /// Adds 'amount' to the weight of this constraint, and of its variables.
+  inline void addWdeg(double amount) {
+    wdeg += amount;
     vector<AnyVarRef>* vars = getVarsSingleton();
     size_t vars_s = vars->size();
     for(size_t i = 0; i < vars_s; i++)
-      (*vars)[i].incWdeg();
+      (*vars)[i].incWdeg(amount);
+  }
+
+  /// Called when propagating this constraint fails.
+  inline void incWdeg() {
+    addWdeg(getState().conflictWeightIncrease(this));
+    const vector<WdegListener*>& listeners = getState().getWdegListeners();
+    for(size_t i = 0; i < listeners.size(); i++)
+      listeners[i]->wdegChanged(this);
   }
-#endif
 
   /// Allows functions to activate a special kind of trigger, run only
   /// after the normal queue is empty.
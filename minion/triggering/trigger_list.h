@@ -84,13 +84,19 @@ public:
       getQueue().pushDynamicTriggers(DynamicTriggerEvent(trig, checked_cast<SysInt>(domain_delta)));
   }
 
+  // Variables with domain triggers report each removed value through
+  // pushDomain_removal, others only report how far their bounds moved.
   void pushUpper(DomainInt varNum, DomainInt upper_delta) {
     D_ASSERT(upper_delta > 0 || getState().isFailed());
+    if(onlyBounds)
+      getQueue().countRemovedValues(upper_delta);
     dynamic_propagate(varNum, UpperBound, upper_delta);
   }
 
   void pushLower(DomainInt varNum, DomainInt lower_delta) {
     D_ASSERT(lower_delta > 0 || getState().isFailed());
+    if(onlyBounds)
+      getQueue().countRemovedValues(lower_delta);
     dynamic_propagate(varNum, LowerBound, lower_delta);
   }
 
@@ -104,6 +110,7 @@ public:
 
   void pushDomain_removal(DomainInt varNum, DomainInt val_removed) {
     D_ASSERT(!onlyBounds);
+    getQueue().countRemovedValues(1);
     dynamic_propagate(varNum, DomainRemoval, -1, val_removed);
   }
 
@@ -147,7 +154,7 @@ public:
 };
 
 inline void attachTriggerToNullList(Trig_ConRef t, TrigOp op) {
-  static DynamicTriggerList dt;
+  static thread_local DynamicTriggerList dt;
   DynamicTriggerList* queue = &dt;
 
   if(op == TO_Backtrack) {
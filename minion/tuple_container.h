@@ -289,8 +289,9 @@ public:
     return initialDomainList;
   }
 
-  ShortTupleList(const vector<vector<pair<SysInt, DomainInt>>>& _shortTuples)
-      : shortTuples(_shortTuples) {}
+  ShortTupleList(const vector<vector<pair<SysInt, DomainInt>>>& _shortTuples,
+                 const vector<set<DomainInt>>& _initialDomains = vector<set<DomainInt>>())
+      : shortTuples(_shortTuples), initialDomainList(_initialDomains) {}
 
   // method : 0 - nothing, 1 - long tuples, 2 - eager, 3 - lazy
   ShortTupleList(std::shared_ptr<TupleList> longTuples, MapLongTuplesToShort method) {
@@ -385,8 +386,9 @@ class ShortTupleListContainer {
   std::vector<std::shared_ptr<ShortTupleList>> InternalTupleList;
 
 public:
-  std::shared_ptr<ShortTupleList> getNewShortTupleList(const vector<vector<pair<SysInt, DomainInt>>>& tuples) {
-    std::shared_ptr<ShortTupleList> tuplelistPtr = std::make_shared<ShortTupleList>(tuples);
+  std::shared_ptr<ShortTupleList> getNewShortTupleList(const vector<vector<pair<SysInt, DomainInt>>>& tuples,
+                                                       const vector<set<DomainInt>>& initialDomains = vector<set<DomainInt>>()) {
+    std::shared_ptr<ShortTupleList> tuplelistPtr = std::make_shared<ShortTupleList>(tuples, initialDomains);
     InternalTupleList.push_back(tuplelistPtr);
     return tuplelistPtr;
   }
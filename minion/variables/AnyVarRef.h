@@ -57,10 +57,8 @@ struct AnyVarRef_Abstract {
   virtual DomainInt getBaseVal(DomainInt) const = 0;
   virtual Var getBaseVar() const = 0;
   virtual vector<Mapper> getMapperStack() const = 0;
-#ifdef WDEG
-  virtual DomainInt getBaseWdeg() = 0;
-  virtual void incWdeg() = 0;
-#endif
+  virtual double getBaseWdeg() = 0;
+  virtual void incWdeg(double amount) = 0;
 
   virtual string virtualTostring() = 0;
 
@@ -168,14 +166,12 @@ struct AnyVarRef_Concrete : public AnyVarRef_Abstract {
     return data.getBaseVar();
   }
 
-#ifdef WDEG
-  virtual DomainInt getBaseWdeg() {
+  virtual double getBaseWdeg() {
     return data.getBaseWdeg();
   }
-  virtual void incWdeg() {
-    data.incWdeg();
+  virtual void incWdeg(double amount) {
+    data.incWdeg(amount);
   }
-#endif
 
   virtual string virtualTostring() {
     return tostring(data);
@@ -307,15 +303,13 @@ public:
     return data->getMapperStack();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return data->getBaseWdeg();
   }
 
-  void incWdeg() {
-    data->incWdeg();
+  void incWdeg(double amount) {
+    data->incWdeg(amount);
   }
-#endif
 
   friend std::ostream& operator<<(std::ostream& o, const AnyVarRef& avr) {
     return o << "AnyVarRef:" << avr.data->virtualTostring();
@@ -114,15 +114,13 @@ struct VarRefType {
     return GET_CONTAINER().getBaseVar(data);
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return GET_CONTAINER().getBaseWdeg(data);
   }
 
-  void incWdeg() {
-    GET_CONTAINER().incWdeg(data);
+  void incWdeg(double amount) {
+    GET_CONTAINER().incWdeg(data, amount);
   }
-#endif
 
   friend std::ostream& operator<<(std::ostream& o, const VarRefType& v) {
     return o << InternalRefType::name() << v.data.varNum;
@@ -241,15 +239,13 @@ struct QuickVarRefType {
     return vector<Mapper>();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return GET_CONTAINER().getBaseWdeg(data);
   }
 
-  void incWdeg() {
-    GET_CONTAINER().incWdeg(data);
+  void incWdeg(double amount) {
+    GET_CONTAINER().incWdeg(data, amount);
   }
-#endif
 
   friend std::ostream& operator<<(std::ostream& o, const QuickVarRefType& b) {
     return o << "Bool:" << b.data;
@@ -17,6 +17,7 @@ also appear. A boolean variable x's negation is identified by !x.
 
 #include "../../memory_management/MemoryBlock.h"
 
+#include "../../search/learning_trail.h"
 #include "../../triggering/constraint_abstract.h"
 
 /// Standard data type used for storing compressed booleans
@@ -153,7 +154,8 @@ typedef QuickVarRefType<GetBoolVarContainer, BoolVarRef_internal> BoolVarRef;
 /// Container for boolean variables
 struct BoolVarContainer {
 
-  BoolVarContainer() : values_mem(0), varCount_m(0), triggerList(false) {}
+  BoolVarContainer()
+      : values_mem(0), varCount_m(0), triggerList(false), learningTrail(nullptr) {}
 
   ~BoolVarContainer() {
       free(values_mem);
@@ -163,11 +165,11 @@ struct BoolVarContainer {
   ExtendableBlock assignOffset;
   void* values_mem;
   vector<vector<AbstractConstraint*>> constraints;
-#ifdef WDEG
-  vector<DomainInt> wdegs;
-#endif
+  vector<double> wdegs;
   UnsignedSysInt varCount_m;
   TriggerList triggerList;
+  // Set by -learning, which needs the reason for every assignment.
+  LearningTrail* learningTrail;
 
   data_type* valuePtr() {
     return static_cast<data_type*>(values_mem);
@@ -202,9 +204,7 @@ struct BoolVarContainer {
       getMemory().backTrack().resizeExtendableBlock(assignOffset, required_mem);
     }
     constraints.resize(varCount_m);
-#ifdef WDEG
     wdegs.resize(varCount_m);
-#endif
     std::vector<std::pair<DomainInt, DomainInt>> doms(new_bools,
                                                       make_pair(DomainInt(0), DomainInt(1)));
     triggerList.addVariables(doms);
@@ -259,6 +259,8 @@ struct BoolVarContainer {
       return;
     }
     assign_ptr()[d.dataOffset()] |= d.shiftOffset;
+    if(learningTrail)
+      learningTrail->assigned(d.varNum);
 
     triggerList.push_assign(d.varNum, b);
     triggerList.pushDomainChanged(d.varNum);
@@ -299,20 +301,16 @@ struct BoolVarContainer {
 
   void addConstraint(const BoolVarRef_internal& b, AbstractConstraint* c) {
     constraints[b.varNum].push_back(c);
-#ifdef WDEG
-    wdegs[b.varNum] += checked_cast<SysInt>(c->getWdeg()); // add constraint score to base var wdeg
-#endif
+    wdegs[b.varNum] += c->getWdeg(); // add constraint score to base var wdeg
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg(const BoolVarRef_internal& b) {
+  double getBaseWdeg(const BoolVarRef_internal& b) {
     return wdegs[b.varNum];
   }
 
-  void incWdeg(const BoolVarRef_internal& b) {
-    wdegs[b.varNum]++;
+  void incWdeg(const BoolVarRef_internal& b, double amount) {
+    wdegs[b.varNum] += amount;
   }
-#endif
 };
 
 inline BoolVarRef BoolVarContainer::getVarNum(DomainInt i) {
@@ -128,15 +128,13 @@ struct BoundVarRef_internal {
     return vector<Mapper>();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return GET_LOCAL_CON().getBaseWdeg(*this);
   }
 
-  void incWdeg() {
-    GET_LOCAL_CON().incWdeg(*this);
+  void incWdeg(double amount) {
+    GET_LOCAL_CON().incWdeg(*this, amount);
   }
-#endif
 
   friend std::ostream& operator<<(std::ostream& o, const BoundVarRef_internal& v) {
     return o << "BoundVar:" << v.varNum;
@@ -167,9 +165,7 @@ struct BoundVarContainer {
   TriggerList triggerList;
   vector<pair<BoundType, BoundType>> initialBounds;
   vector<vector<AbstractConstraint*>> constraints;
-#ifdef WDEG
-  vector<UnsignedSysInt> wdegs;
-#endif
+  vector<double> wdegs;
   UnsignedSysInt varCount_m;
 
   const BoundType& lowerBound(const BoundVarRef_internal<BoundType>& i) const {
@@ -336,9 +332,7 @@ struct BoundVarContainer {
     varCount_m += count;
 
     constraints.resize(varCount_m);
-#ifdef WDEG
     wdegs.resize(varCount_m);
-#endif
 
     if(bound_data.empty()) {
       bound_data =
@@ -374,20 +368,16 @@ struct BoundVarContainer {
 
   void addConstraint(const BoundVarRef_internal<BoundType>& b, AbstractConstraint* c) {
     constraints[checked_cast<SysInt>(b.varNum)].push_back(c);
-#ifdef WDEG
     wdegs[checked_cast<SysInt>(b.varNum)] += c->getWdeg(); // add constraint score to base var wdeg
-#endif
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg(const BoundVarRef_internal<BoundType>& b) {
+  double getBaseWdeg(const BoundVarRef_internal<BoundType>& b) {
     return wdegs[checked_cast<SysInt>(b.varNum)];
   }
 
-  void incWdeg(const BoundVarRef_internal<BoundType>& b) {
-    wdegs[checked_cast<SysInt>(b.varNum)]++;
+  void incWdeg(const BoundVarRef_internal<BoundType>& b, double amount) {
+    wdegs[checked_cast<SysInt>(b.varNum)] += amount;
   }
-#endif
 
   void addDynamicTrigger(BoundVarRef_internal<BoundType>& b, Trig_ConRef t, TrigType type,
                          DomainInt pos = NoDomainValue, TrigOp op = TO_Default) {
@@ -64,9 +64,7 @@ struct BigRangeVarContainer {
   vector<DomainInt> varOffset;
   /// Constraints variable participates in
   vector<vector<AbstractConstraint*>> constraints;
-#ifdef WDEG
-  vector<DomainInt> wdegs;
-#endif
+  vector<double> wdegs;
 
   UnsignedSysInt varCount_m;
 
@@ -95,20 +93,16 @@ struct BigRangeVarContainer {
   DomainInt findNewUpperBound(BigRangeVarRef_internal d) {
     DomainInt lower = lowerBound(d);
     DomainInt oldUpBound = upperBound(d);
-    DomainInt loopvar = oldUpBound;
-    // DomainInt lowBound = initialBounds[d.varNum].first;
-    if(loopvar < lower) {
+    if(oldUpBound < lower) {
       getState().setFailed();
       /// Here just remove the value which should lead to the least work.
       return upperBound(d);
     }
-    if(bms_array->isMember(varOffset[d.varNum] + loopvar) && (loopvar >= lower))
-      return upperBound(d);
-    --loopvar;
-    for(; loopvar >= lower; --loopvar) {
-      if(bms_array->isMember(varOffset[d.varNum] + loopvar))
-        return loopvar;
-    }
+    DomainInt domainOffset = varOffset[d.varNum];
+    DomainInt newUpBound =
+        bms_array->prevMember(domainOffset + lower, domainOffset + oldUpBound) - domainOffset;
+    if(newUpBound >= lower)
+      return newUpBound;
     getState().setFailed();
     return oldUpBound;
   }
@@ -120,20 +114,16 @@ struct BigRangeVarContainer {
   DomainInt findNewLowerBound(BigRangeVarRef_internal d) {
     DomainInt upper = upperBound(d);
     DomainInt old_lowBound = lowerBound(d);
-    DomainInt loopvar = old_lowBound;
-    // DomainInt lowBound = initialBounds[d.varNum].first;
-    if(loopvar > upper) {
+    if(old_lowBound > upper) {
       getState().setFailed();
       /// Here just remove the value which should lead to the least work.
       return lowerBound(d);
     }
-    if(bms_array->isMember(varOffset[d.varNum] + loopvar) && (loopvar <= upper))
-      return lowerBound(d);
-    ++loopvar;
-    for(; loopvar <= upper; ++loopvar) {
-      if(bms_array->isMember(varOffset[d.varNum] + loopvar))
-        return loopvar;
-    }
+    DomainInt domainOffset = varOffset[d.varNum];
+    DomainInt newLowBound =
+        bms_array->nextMember(domainOffset + old_lowBound, domainOffset + upper) - domainOffset;
+    if(newLowBound <= upper)
+      return newLowBound;
     getState().setFailed();
     return old_lowBound;
   }
@@ -147,9 +137,7 @@ struct BigRangeVarContainer {
       varCount_m++;
     }
     constraints.resize(newDomains.size());
-#ifdef WDEG
     wdegs.resize(newDomains.size());
-#endif
 
     bound_data = getMemory().backTrack().requestBytesExtendable(varCount_m * BOUND_DATA_SIZE *
                                                                 sizeof(domainBound_type));
@@ -208,13 +196,21 @@ struct BigRangeVarContainer {
     return bms_array->isMember(varOffset[d.varNum] + i);
   }
 
-  DomainInt getDomSize_Check(BigRangeVarRef_internal d) const {
-    DomainInt domSize = 0;
-    for(DomainInt i = this->getMin(d); i <= this->getMax(d); ++i) {
-      if(this->inDomain(d, i))
-        domSize++;
+  /// Pushes a domain removal trigger for each value of d in [from, to],
+  /// skipping straight over values which are already removed.
+  void pushDomainRemovals(BigRangeVarRef_internal d, DomainInt from, DomainInt to) {
+    DomainInt domainOffset = varOffset[d.varNum];
+    DomainInt last = domainOffset + to;
+    for(DomainInt loop = bms_array->nextMember(domainOffset + from, last); loop <= last;
+        loop = bms_array->nextMember(loop + 1, last)) {
+      triggerList.pushDomain_removal(d.varNum, loop - domainOffset);
+      reduceDomSize(d);
     }
-    return domSize;
+  }
+
+  DomainInt getDomSize_Check(BigRangeVarRef_internal d) const {
+    DomainInt domainOffset = varOffset[d.varNum];
+    return bms_array->countMembers(domainOffset + lowerBound(d), domainOffset + upperBound(d));
   }
 
   DomainInt getDomSize(BigRangeVarRef_internal d) const {
@@ -323,16 +319,8 @@ struct BigRangeVarContainer {
 private:
   // This function just unifies part of assign and uncheckedAssign
   void commonAssign(BigRangeVarRef_internal d, DomainInt offset, DomainInt lower, DomainInt upper) {
-    // TODO : Optimise this function to only check values in domain.
-    DomainInt domainOffset = varOffset[d.varNum] /*- initialBounds[d.varNum].first*/;
-    for(DomainInt loop = lower; loop <= upper; ++loop) {
-      // def of inDomain: bms_array->isMember(varOffset[d.varNum] + i -
-      // initialBounds[d.varNum].first);
-      if(bms_array->isMember(loop + domainOffset) && loop != offset) {
-        triggerList.pushDomain_removal(d.varNum, loop);
-        reduceDomSize(d);
-      }
-    }
+    pushDomainRemovals(d, lower, offset - 1);
+    pushDomainRemovals(d, offset + 1, upper);
     triggerList.pushDomainChanged(d.varNum);
     triggerList.push_assign(d.varNum, offset);
 
@@ -369,16 +357,7 @@ public:
     }
 
     if(offset < upBound) {
-      // TODO : Optimise this function to only check values in domain.
-      DomainInt domainOffset = varOffset[d.varNum] /*- initialBounds[d.varNum].first*/;
-      for(DomainInt loop = offset + 1; loop <= upBound; ++loop) {
-        // Def of inDomain: bms_array->isMember(varOffset[d.varNum] + i -
-        // initialBounds[d.varNum].first);
-        if(bms_array->isMember(domainOffset + loop)) {
-          triggerList.pushDomain_removal(d.varNum, loop);
-          reduceDomSize(d);
-        }
-      }
+      pushDomainRemovals(d, offset + 1, upBound);
       upperBound(d) = offset;
       DomainInt newUpper = findNewUpperBound(d);
       upperBound(d) = newUpper;
@@ -419,16 +398,7 @@ public:
     }
 
     if(offset > lowBound) {
-      // TODO : Optimise this function to only check values in domain.
-      DomainInt domainOffset = varOffset[d.varNum] /*- initialBounds[d.varNum].first*/;
-      for(DomainInt loop = lowBound; loop < offset; ++loop) {
-        // def of inDomain: bms_array->isMember(varOffset[d.varNum] + i -
-        // initialBounds[d.varNum].first);
-        if(bms_array->isMember(loop + domainOffset)) {
-          triggerList.pushDomain_removal(d.varNum, loop);
-          reduceDomSize(d);
-        }
-      }
+      pushDomainRemovals(d, lowBound, offset - 1);
       D_ASSERT(getState().isFailed() ||
                (inDomain(d, lowerBound(d)) && inDomain(d, upperBound(d))));
 
@@ -475,9 +445,7 @@ public:
 
   void addConstraint(const BigRangeVarRef_internal& b, AbstractConstraint* c) {
     constraints[b.varNum].push_back(c);
-#ifdef WDEG
     wdegs[b.varNum] += c->getWdeg(); // add constraint score to base var wdeg
-#endif
   }
 
   DomainInt getBaseVal(const BigRangeVarRef_internal& b, DomainInt v) const {
@@ -493,15 +461,13 @@ public:
     return vector<Mapper>();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg(const BigRangeVarRef_internal& b) {
+  double getBaseWdeg(const BigRangeVarRef_internal& b) {
     return wdegs[b.varNum];
   }
 
-  void incWdeg(const BigRangeVarRef_internal& b) {
-    wdegs[b.varNum]++;
+  void incWdeg(const BigRangeVarRef_internal& b, double amount) {
+    wdegs[b.varNum] += amount;
   }
-#endif
 
   ~BigRangeVarContainer() {
     for(UnsignedSysInt i = 0; i < varCount_m; i++) {
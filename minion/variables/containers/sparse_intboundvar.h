@@ -64,9 +64,7 @@ struct SparseBoundVarContainer {
   vector<vector<BoundType>> domains;
   vector<DomainInt> domain_reference;
   vector<vector<AbstractConstraint*>> constraints;
-#ifdef WDEG
-  vector<UnsignedSysInt> wdegs;
-#endif
+  vector<double> wdegs;
   UnsignedSysInt varCount_m;
 
   SparseBoundVarContainer() : triggerList(true), varCount_m(0) {}
@@ -161,9 +159,7 @@ struct SparseBoundVarContainer {
     varCount_m = domain_reference.size();
 
     constraints.resize(varCount_m);
-#ifdef WDEG
     wdegs.resize(varCount_m);
-#endif
 
     if(bound_data.empty()) {
       bound_data =
@@ -213,12 +209,11 @@ struct SparseBoundVarContainer {
   }
 
   DomainInt getDomSize(SparseBoundVarRef_internal<BoundType> d) const {
-    DomainInt domSize = 0;
-    for(DomainInt i = this->getMin(d); i <= this->getMax(d); ++i) {
-      if(this->inDomain(d, i))
-        domSize++;
-    }
-    return domSize;
+    // The domain vector is sorted, so count the values between the bounds.
+    const vector<BoundType>& dom =
+        domains[checked_cast<SysInt>(domain_reference[checked_cast<SysInt>(d.varNum)])];
+    return std::upper_bound(dom.begin(), dom.end(), getMax(d)) -
+           std::lower_bound(dom.begin(), dom.end(), getMin(d));
   }
 
   DomainInt getMin(SparseBoundVarRef_internal<BoundType> d) const {
@@ -354,9 +349,7 @@ struct SparseBoundVarContainer {
 
   void addConstraint(const SparseBoundVarRef_internal<BoundType>& b, AbstractConstraint* c) {
     constraints[b.varNum].push_back(c);
-#ifdef WDEG
     wdegs[b.varNum] += c->getWdeg(); // add constraint score to base var wdeg
-#endif
   }
 
   DomainInt getBaseVal(const SparseBoundVarRef_internal<BoundType>& b, DomainInt v) const {
@@ -372,15 +365,13 @@ struct SparseBoundVarContainer {
     return vector<Mapper>();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg(const SparseBoundVarRef_internal<BoundType>& b) {
+  double getBaseWdeg(const SparseBoundVarRef_internal<BoundType>& b) {
     return wdegs[b.varNum];
   }
 
-  void incWdeg(const SparseBoundVarRef_internal<BoundType>& b) {
-    wdegs[b.varNum]++;
+  void incWdeg(const SparseBoundVarRef_internal<BoundType>& b, double amount) {
+    wdegs[b.varNum] += amount;
   }
-#endif
 
   void addDynamicTrigger(SparseBoundVarRef_internal<BoundType> b, Trig_ConRef t, TrigType type,
                          DomainInt pos = NoDomainValue, TrigOp op = TO_Default) {
@@ -124,15 +124,13 @@ struct ConstantVar {
     return vector<Mapper>();
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return 0;
   } // wdeg is irrelevant for non-search var
 
-  void incWdeg() {
+  void incWdeg(double amount) {
     ;
   }
-#endif
 
   DomainInt getDomainChange(DomainDelta d) {
     D_ASSERT(d.XXX_getDomain_diff() == 0);
@@ -140,15 +140,13 @@ struct VarNeg {
     return v;
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return data.getBaseWdeg();
   }
 
-  void incWdeg() {
-    data.incWdeg();
+  void incWdeg(double amount) {
+    data.incWdeg(amount);
   }
-#endif
 };
 
 template <typename T>
@@ -157,15 +157,13 @@ struct VarNot {
     return v;
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return data.getBaseWdeg();
   }
 
-  void incWdeg() {
-    data.incWdeg();
+  void incWdeg(double amount) {
+    data.incWdeg(amount);
   }
-#endif
 };
 
 template <typename T>
@@ -126,15 +126,13 @@ struct ShiftVar {
     return v;
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return data.getBaseWdeg();
   }
 
-  void incWdeg() {
-    data.incWdeg();
+  void incWdeg(double amount) {
+    data.incWdeg(amount);
   }
-#endif
 };
 
 template <typename T, typename U>
@@ -200,13 +200,11 @@ template<typename VarRef, typename DataMap = TrivialDataMap>
   VarIdent getIdent()
   { return VarIdent(stretchT, Multiply, data.getIdent()); }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg()
+  double getBaseWdeg()
   { return data.getBaseWdeg(); }
 
-  void incWdeg()
-  { data.incWdeg(); }
-#endif
+  void incWdeg(double amount)
+  { data.incWdeg(amount); }
 };
 
 #endif
@@ -383,15 +381,13 @@ struct MultiplyVar {
     return v;
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return data.getBaseWdeg();
   }
 
-  void incWdeg() {
-    data.incWdeg();
+  void incWdeg(double amount) {
+    data.incWdeg(amount);
   }
-#endif
 };
 
 template <typename T>
@@ -161,15 +161,13 @@ struct SwitchNeg {
     return v;
   }
 
-#ifdef WDEG
-  DomainInt getBaseWdeg() {
+  double getBaseWdeg() {
     return data.getBaseWdeg();
   }
 
-  void incWdeg() {
-    data.incWdeg();
+  void incWdeg(double amount) {
+    data.incWdeg(amount);
   }
-#endif
 };
 
 template <typename T>
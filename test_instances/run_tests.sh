@@ -43,12 +43,12 @@ echo Testing $exec with options .$*.
   failed=$(($failed + $?))
   ./do_random_tests.sh 3 $exec $* -varorder ldf-random
   failed=$(($failed + $?))
-if $exec | grep "wdeg on" > /dev/null; then
   ./do_random_tests.sh 3 $exec $* -varorder wdeg
   failed=$(($failed + $?))
   ./do_random_tests.sh 3 $exec $* -varorder domoverwdeg
   failed=$(($failed + $?))
-fi
+  ./do_random_tests.sh 3 $exec $* -varorder domoverwdeg -weighting chs
+  failed=$(($failed + $?))
   if [ $failed -gt 0 ]; then
     exit $failed
   fi
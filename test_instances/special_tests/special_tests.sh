@@ -39,6 +39,48 @@ for file in bibd.minion; do
   fi
 done
 
+for file in ../test_lex_2.minion ../test_litsum_5.minion; do
+  sols=`$exec $file -findallsols -noprintsols | grep '^Solutions Found' | awk '{print $3}'`
+  for flags in "" "-steallow"; do
+    if [[ "`$exec $file -findallsols -noprintsols -threads 3 $flags | grep '^Solutions Found' | awk '{print $3}'`" != "$sols" ]]; then
+      echo Threads test $file $flags failed
+      exit 1
+    fi
+  done
+done
+
+for file in ../test_lex_2.minion ../test_watchedor_5.minion ../reifyimply_test_1.minion \
+            ../test_sumleq_5.minion ../../benchmarks/SAT/qg7-11watched.minion; do
+  sols=`$exec $file -findallsols -noprintsols | grep '^Solutions Found' | awk '{print $3}'`
+  if [[ "`$exec $file -findallsols -noprintsols -learning | grep '^Solutions Found' | awk '{print $3}'`" != "$sols" ]]; then
+    echo Learning test $file failed
+    exit 1
+  fi
+done
+
+for file in ../primequeens5.minion ../new_optimise_list_2.minion; do
+  best=`$exec $file -noprintsols | grep '^Solution found with Value' | tail -1`
+  for flags in "-threads 3" "-threads 3 -steallow" "-portfolio 3"; do
+    if [[ "`$exec $file -noprintsols $flags | grep '^Solution found with Value' | tail -1`" != "$best" ]]; then
+      echo Threads optimisation test $file $flags failed
+      exit 1
+    fi
+  done
+done
+
+for file in ../new_format_examples.minion ../circulargolombruler.minion ../basic_short_table_1.minion \
+            ../test_watchedor_1.minion ../new_optimise_list_2.minion bibd.minion; do
+  for flags in "" "-map-long-short eager"; do
+    $exec $file $flags -binaryout binary_test.bin > /dev/null
+    if ! diff <($exec $file $flags -findallsols | grep -e '^Sol:' -e '^Solutions Found' -e '^Nodes') \
+              <($exec binary_test.bin -findallsols | grep -e '^Sol:' -e '^Solutions Found' -e '^Nodes'); then
+      echo Binary instance test $file $flags failed
+      rm -f binary_test.bin
+      exit 1
+    fi
+  done
+done
+rm -f binary_test.bin
 
 #if [[ "`$exec meb-inst-18-09.eprime-param.minion  -nodelimit 50000 | grep 'Value: ' | awk '{print $2}'`" != "-1045," ]]; then
 #  echo Neighbourhood test failed